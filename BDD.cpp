@@ -0,0 +1,653 @@
+#include "BDD.h"
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_map>
+#include <string>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+const uint32_t ZERO = 0;
+const uint32_t ONE = 1;
+const uint32_t NIL = UINT32_MAX;
+const uint32_t FREE = UINT32_MAX; // variable of the nodes in the free list
+
+const uint32_t OP_AND = 1;
+const uint32_t OP_OR = 2;
+const uint32_t OP_NOT = 3;
+const uint32_t OP_ITE = 4;
+const uint32_t OP_EXISTS = 5;
+const uint32_t OP_AND_EXISTS = 6;
+const uint32_t OP_RESTRICT = 7;
+
+const size_t INITIAL_NUM_BUCKETS = 1 << 12;
+const size_t INITIAL_GC_THRESHOLD = 1 << 16;
+
+} // namespace
+
+BDD::BDD() : manager_(nullptr), node_(ZERO) {
+}
+
+BDD::BDD(BDDManager *manager, uint32_t node) : manager_(manager), node_(node) {
+    if (manager_ != nullptr) {
+        manager_->ref(node_);
+    }
+}
+
+BDD::BDD(const BDD &other) : manager_(other.manager_), node_(other.node_) {
+    if (manager_ != nullptr) {
+        manager_->ref(node_);
+    }
+}
+
+BDD &BDD::operator=(const BDD &other) {
+    if (other.manager_ != nullptr) {
+        other.manager_->ref(other.node_);
+    }
+    if (manager_ != nullptr) {
+        manager_->deref(node_);
+    }
+    manager_ = other.manager_;
+    node_ = other.node_;
+    return *this;
+}
+
+BDD::~BDD() {
+    if (manager_ != nullptr) {
+        manager_->deref(node_);
+    }
+}
+
+bool BDD::operator==(const BDD &other) const {
+    return (manager_ == other.manager_) && (node_ == other.node_);
+}
+
+bool BDD::operator!=(const BDD &other) const {
+    return !(*this == other);
+}
+
+BDD BDD::operator&(const BDD &other) const {
+    return manager_->apply_and(*this, other);
+}
+
+BDD BDD::operator|(const BDD &other) const {
+    return manager_->apply_or(*this, other);
+}
+
+bool BDD::isZero() const {
+    return node_ == ZERO;
+}
+
+bool BDD::isOne() const {
+    return node_ == ONE;
+}
+
+BDDManager::BDDManager(int num_vars, size_t max_nodes) {
+    if (num_vars < 0) {
+        throw invalid_argument("Invalid number of variables: " + to_string(num_vars));
+    }
+
+    num_vars_ = num_vars;
+    max_nodes_ = max_nodes;
+    gc_threshold_ = INITIAL_GC_THRESHOLD;
+    num_free_ = 0;
+    free_list_ = NIL;
+
+    // the terminals have the variable num_vars, below all the other variables, and are never collected
+    nodes_.push_back({(uint32_t) num_vars_, ZERO, ZERO, NIL, 1});
+    nodes_.push_back({(uint32_t) num_vars_, ONE, ONE, NIL, 1});
+
+    buckets_.assign(INITIAL_NUM_BUCKETS, NIL);
+    cache_.assign(INITIAL_NUM_BUCKETS, {0, 0, 0, 0, 0});
+}
+
+int BDDManager::numVars() {
+    return num_vars_;
+}
+
+BDD BDDManager::zero() {
+    return BDD(this, ZERO);
+}
+
+BDD BDDManager::one() {
+    return BDD(this, ONE);
+}
+
+BDD BDDManager::var(int v) {
+    validateVar(v);
+    maybeGarbageCollect();
+    return BDD(this, mk(v, ZERO, ONE));
+}
+
+BDD BDDManager::nvar(int v) {
+    validateVar(v);
+    maybeGarbageCollect();
+    return BDD(this, mk(v, ONE, ZERO));
+}
+
+BDD BDDManager::apply_and(const BDD &f, const BDD &g) {
+    validate(f);
+    validate(g);
+    maybeGarbageCollect();
+    return BDD(this, andRec(f.node_, g.node_));
+}
+
+BDD BDDManager::apply_or(const BDD &f, const BDD &g) {
+    validate(f);
+    validate(g);
+    maybeGarbageCollect();
+    return BDD(this, orRec(f.node_, g.node_));
+}
+
+BDD BDDManager::ite(const BDD &f, const BDD &g, const BDD &h) {
+    validate(f);
+    validate(g);
+    validate(h);
+    maybeGarbageCollect();
+    return BDD(this, iteRec(f.node_, g.node_, h.node_));
+}
+
+BDD BDDManager::restrict(const BDD &f, int v, bool value) {
+    validate(f);
+    validateVar(v);
+    maybeGarbageCollect();
+    return BDD(this, restrictRec(f.node_, v, value ? ONE : ZERO));
+}
+
+BDD BDDManager::andExists(const BDD &f, const BDD &g, const BDD &cube) {
+    validate(f);
+    validate(g);
+    validate(cube);
+    maybeGarbageCollect();
+    return BDD(this, andExistsRec(f.node_, g.node_, cube.node_));
+}
+
+BDD BDDManager::permute(const BDD &f, const vector<int> &permutation) {
+    validate(f);
+    if (((int) permutation.size()) != num_vars_) {
+        throw invalid_argument("Invalid permutation size: " + to_string(permutation.size()));
+    }
+    for (int v : permutation) {
+        validateVar(v);
+    }
+
+    maybeGarbageCollect();
+
+    unordered_map<uint32_t, uint32_t> computed;
+    function<uint32_t(uint32_t)> permuteRec = [&](uint32_t node) -> uint32_t {
+        if (node <= ONE) {
+            return node;
+        }
+        auto it = computed.find(node);
+        if (it != computed.end()) {
+            return it->second;
+        }
+
+        uint32_t var = nodes_[node].var;
+        uint32_t high = nodes_[node].high;
+        uint32_t low = permuteRec(nodes_[node].low);
+        high = permuteRec(high);
+
+        // the new variable may be anywhere in the order, so the node is rebuilt with ite
+        uint32_t result = iteRec(mk(permutation[var], ZERO, ONE), high, low);
+        computed[node] = result;
+        return result;
+    };
+
+    return BDD(this, permuteRec(f.node_));
+}
+
+double BDDManager::satCount(const BDD &f, const vector<int> &vars) {
+    validate(f);
+
+    // position of each variable in vars; the terminals are after all of them
+    vector<int> position(num_vars_ + 1, -1);
+    for (size_t i = 0; i < vars.size(); i++) {
+        validateVar(vars[i]);
+        if ((i > 0) && (vars[i] <= vars[i - 1])) {
+            throw invalid_argument("The variables must be in increasing order");
+        }
+        position[vars[i]] = i;
+    }
+    position[num_vars_] = vars.size();
+
+    unordered_map<uint32_t, double> computed;
+    function<double(uint32_t)> countRec = [&](uint32_t node) -> double {
+        if (node <= ONE) {
+            return node;
+        }
+        auto it = computed.find(node);
+        if (it != computed.end()) {
+            return it->second;
+        }
+
+        const Node &n = nodes_[node];
+        if (position[n.var] < 0) {
+            throw invalid_argument("The BDD depends on variable " + to_string(n.var) + ", which is not counted");
+        }
+
+        // the variables skipped between a node and its children can take any value
+        uint32_t low = n.low, high = n.high;
+        int p = position[n.var];
+        double result = countRec(low) * pow(2.0, position[nodes_[low].var] - p - 1) +
+            countRec(high) * pow(2.0, position[nodes_[high].var] - p - 1);
+
+        computed[node] = result;
+        return result;
+    };
+
+    return countRec(f.node_) * pow(2.0, position[nodes_[f.node_].var]);
+}
+
+void BDDManager::enumerate(const BDD &f, const vector<int> &vars, const function<void(const vector<int> &)> &callback) {
+    validate(f);
+    for (size_t i = 0; i < vars.size(); i++) {
+        validateVar(vars[i]);
+        if ((i > 0) && (vars[i] <= vars[i - 1])) {
+            throw invalid_argument("The variables must be in increasing order");
+        }
+    }
+
+    vector<int> true_positions;
+    function<void(uint32_t, size_t)> enumerateRec = [&](uint32_t node, size_t i) {
+        if (node == ZERO) {
+            return;
+        }
+        if (i == vars.size()) {
+            if (node != ONE) {
+                throw invalid_argument("The BDD depends on variable " + to_string(nodes_[node].var) + ", which is not enumerated");
+            }
+            callback(true_positions);
+            return;
+        }
+
+        uint32_t var = nodes_[node].var;
+        if (var < (uint32_t) vars[i]) {
+            throw invalid_argument("The BDD depends on variable " + to_string(var) + ", which is not enumerated");
+        }
+
+        // when the variable is skipped by the node, both of its values lead to the same node
+        uint32_t low = (var == (uint32_t) vars[i]) ? nodes_[node].low : node;
+        uint32_t high = (var == (uint32_t) vars[i]) ? nodes_[node].high : node;
+
+        // the assignments with the variable true come first, so the lists of positions are in lexicographic order
+        true_positions.push_back(i);
+        enumerateRec(high, i + 1);
+        true_positions.pop_back();
+        enumerateRec(low, i + 1);
+    };
+
+    enumerateRec(f.node_, 0);
+}
+
+size_t BDDManager::numNodes() {
+    return nodes_.size() - num_free_;
+}
+
+size_t BDDManager::memoryUsage() {
+    return nodes_.capacity() * sizeof(Node) + buckets_.capacity() * sizeof(uint32_t) + cache_.capacity() * sizeof(CacheEntry);
+}
+
+size_t BDDManager::bytesPerNode() {
+    // the unique table has up to one bucket per node and the computed table has one entry per bucket
+    return sizeof(Node) + sizeof(uint32_t) + sizeof(CacheEntry);
+}
+
+void BDDManager::ref(uint32_t node) {
+    nodes_[node].ref++;
+}
+
+void BDDManager::deref(uint32_t node) {
+    nodes_[node].ref--;
+}
+
+uint32_t BDDManager::mk(uint32_t var, uint32_t low, uint32_t high) {
+    if (low == high) {
+        return low;
+    }
+
+    uint32_t bucket = hash(var, low, high);
+    for (uint32_t node = buckets_[bucket]; node != NIL; node = nodes_[node].next) {
+        if ((nodes_[node].var == var) && (nodes_[node].low == low) && (nodes_[node].high == high)) {
+            return node;
+        }
+    }
+
+    uint32_t node;
+    if (free_list_ != NIL) {
+        node = free_list_;
+        free_list_ = nodes_[node].next;
+        num_free_--;
+    } else {
+        if ((max_nodes_ > 0) && (nodes_.size() >= max_nodes_)) {
+            throw length_error("BDD node limit exceeded: " + to_string(max_nodes_) + " nodes");
+        }
+        node = nodes_.size();
+        nodes_.push_back(Node());
+    }
+
+    nodes_[node] = {var, low, high, buckets_[bucket], 0};
+    buckets_[bucket] = node;
+
+    if (numNodes() > 2 * buckets_.size()) {
+        resizeBuckets();
+    }
+
+    return node;
+}
+
+uint32_t BDDManager::hash(uint32_t var, uint32_t low, uint32_t high) {
+    uint64_t h = var * 0x9e3779b97f4a7c15ULL;
+    h ^= (low + 0x632be59bd9b4e019ULL + (h << 6) + (h >> 2)) * 0xbf58476d1ce4e5b9ULL;
+    h ^= (high + 0x85157af5ULL + (h << 6) + (h >> 2)) * 0x94d049bb133111ebULL;
+    return (uint32_t) ((h ^ (h >> 32)) & (buckets_.size() - 1));
+}
+
+void BDDManager::resizeBuckets() {
+    buckets_.assign(2 * buckets_.size(), NIL);
+    for (uint32_t node = ONE + 1; node < nodes_.size(); node++) {
+        if (nodes_[node].var != FREE) {
+            uint32_t bucket = hash(nodes_[node].var, nodes_[node].low, nodes_[node].high);
+            nodes_[node].next = buckets_[bucket];
+            buckets_[bucket] = node;
+        }
+    }
+
+    // the computed table grows with the unique table; its entries are only hints, so they can be dropped
+    cache_.assign(buckets_.size(), {0, 0, 0, 0, 0});
+}
+
+void BDDManager::maybeGarbageCollect() {
+    bool near_limit = (max_nodes_ > 0) && (nodes_.size() + nodes_.size() / 8 >= max_nodes_) && (num_free_ < nodes_.size() / 8);
+    if ((numNodes() > gc_threshold_) || near_limit) {
+        garbageCollect();
+    }
+}
+
+void BDDManager::garbageCollect() {
+    vector<char> marked(nodes_.size(), false);
+    marked[ZERO] = marked[ONE] = true;
+
+    vector<uint32_t> stack;
+    for (uint32_t node = ONE + 1; node < nodes_.size(); node++) {
+        if ((nodes_[node].var != FREE) && (nodes_[node].ref > 0)) {
+            stack.push_back(node);
+        }
+    }
+    while (!stack.empty()) {
+        uint32_t node = stack.back();
+        stack.pop_back();
+        if (!marked[node]) {
+            marked[node] = true;
+            stack.push_back(nodes_[node].low);
+            stack.push_back(nodes_[node].high);
+        }
+    }
+
+    fill(buckets_.begin(), buckets_.end(), NIL);
+    for (uint32_t node = ONE + 1; node < nodes_.size(); node++) {
+        if (nodes_[node].var == FREE) {
+            continue;
+        }
+        if (marked[node]) {
+            uint32_t bucket = hash(nodes_[node].var, nodes_[node].low, nodes_[node].high);
+            nodes_[node].next = buckets_[bucket];
+            buckets_[bucket] = node;
+        } else {
+            nodes_[node].var = FREE;
+            nodes_[node].next = free_list_;
+            free_list_ = node;
+            num_free_++;
+        }
+    }
+
+    // the computed table may refer to the nodes that were freed
+    fill(cache_.begin(), cache_.end(), CacheEntry({0, 0, 0, 0, 0}));
+
+    gc_threshold_ = max(INITIAL_GC_THRESHOLD, 2 * numNodes());
+}
+
+bool BDDManager::cacheLookup(uint32_t op, uint32_t a, uint32_t b, uint32_t c, uint32_t &result) {
+    const CacheEntry &entry = cache_[(hash(op * 0x45d9f3bU + a, b, c)) & (cache_.size() - 1)];
+    if ((entry.op == op) && (entry.a == a) && (entry.b == b) && (entry.c == c)) {
+        result = entry.result;
+        return true;
+    }
+    return false;
+}
+
+void BDDManager::cacheInsert(uint32_t op, uint32_t a, uint32_t b, uint32_t c, uint32_t result) {
+    cache_[(hash(op * 0x45d9f3bU + a, b, c)) & (cache_.size() - 1)] = {op, a, b, c, result};
+}
+
+uint32_t BDDManager::andRec(uint32_t f, uint32_t g) {
+    if ((f == ZERO) || (g == ZERO)) {
+        return ZERO;
+    }
+    if ((f == ONE) || (f == g)) {
+        return g;
+    }
+    if (g == ONE) {
+        return f;
+    }
+    if (f > g) {
+        swap(f, g);
+    }
+
+    uint32_t result;
+    if (cacheLookup(OP_AND, f, g, 0, result)) {
+        return result;
+    }
+
+    uint32_t var = min(nodes_[f].var, nodes_[g].var);
+    uint32_t f0 = (nodes_[f].var == var) ? nodes_[f].low : f, f1 = (nodes_[f].var == var) ? nodes_[f].high : f;
+    uint32_t g0 = (nodes_[g].var == var) ? nodes_[g].low : g, g1 = (nodes_[g].var == var) ? nodes_[g].high : g;
+
+    uint32_t low = andRec(f0, g0);
+    uint32_t high = andRec(f1, g1);
+    result = mk(var, low, high);
+
+    cacheInsert(OP_AND, f, g, 0, result);
+    return result;
+}
+
+uint32_t BDDManager::orRec(uint32_t f, uint32_t g) {
+    if ((f == ONE) || (g == ONE)) {
+        return ONE;
+    }
+    if ((f == ZERO) || (f == g)) {
+        return g;
+    }
+    if (g == ZERO) {
+        return f;
+    }
+    if (f > g) {
+        swap(f, g);
+    }
+
+    uint32_t result;
+    if (cacheLookup(OP_OR, f, g, 0, result)) {
+        return result;
+    }
+
+    uint32_t var = min(nodes_[f].var, nodes_[g].var);
+    uint32_t f0 = (nodes_[f].var == var) ? nodes_[f].low : f, f1 = (nodes_[f].var == var) ? nodes_[f].high : f;
+    uint32_t g0 = (nodes_[g].var == var) ? nodes_[g].low : g, g1 = (nodes_[g].var == var) ? nodes_[g].high : g;
+
+    uint32_t low = orRec(f0, g0);
+    uint32_t high = orRec(f1, g1);
+    result = mk(var, low, high);
+
+    cacheInsert(OP_OR, f, g, 0, result);
+    return result;
+}
+
+uint32_t BDDManager::notRec(uint32_t f) {
+    if (f <= ONE) {
+        return ONE - f;
+    }
+
+    uint32_t result;
+    if (cacheLookup(OP_NOT, f, 0, 0, result)) {
+        return result;
+    }
+
+    uint32_t var = nodes_[f].var;
+    uint32_t high = nodes_[f].high;
+    uint32_t low = notRec(nodes_[f].low);
+    high = notRec(high);
+    result = mk(var, low, high);
+
+    cacheInsert(OP_NOT, f, 0, 0, result);
+    return result;
+}
+
+uint32_t BDDManager::iteRec(uint32_t f, uint32_t g, uint32_t h) {
+    if (f == ONE) {
+        return g;
+    }
+    if (f == ZERO) {
+        return h;
+    }
+    if (g == h) {
+        return g;
+    }
+    if ((g == ONE) && (h == ZERO)) {
+        return f;
+    }
+    if ((g == ZERO) && (h == ONE)) {
+        return notRec(f);
+    }
+
+    uint32_t result;
+    if (cacheLookup(OP_ITE, f, g, h, result)) {
+        return result;
+    }
+
+    uint32_t var = min(nodes_[f].var, min(nodes_[g].var, nodes_[h].var));
+    uint32_t f0 = (nodes_[f].var == var) ? nodes_[f].low : f, f1 = (nodes_[f].var == var) ? nodes_[f].high : f;
+    uint32_t g0 = (nodes_[g].var == var) ? nodes_[g].low : g, g1 = (nodes_[g].var == var) ? nodes_[g].high : g;
+    uint32_t h0 = (nodes_[h].var == var) ? nodes_[h].low : h, h1 = (nodes_[h].var == var) ? nodes_[h].high : h;
+
+    uint32_t low = iteRec(f0, g0, h0);
+    uint32_t high = iteRec(f1, g1, h1);
+    result = mk(var, low, high);
+
+    cacheInsert(OP_ITE, f, g, h, result);
+    return result;
+}
+
+uint32_t BDDManager::restrictRec(uint32_t f, uint32_t var, uint32_t value) {
+    if (nodes_[f].var > var) {
+        return f; // f does not depend on var (this includes the terminals)
+    }
+    if (nodes_[f].var == var) {
+        return (value == ONE) ? nodes_[f].high : nodes_[f].low;
+    }
+
+    uint32_t result;
+    if (cacheLookup(OP_RESTRICT, f, var, value, result)) {
+        return result;
+    }
+
+    uint32_t f_var = nodes_[f].var;
+    uint32_t f1 = nodes_[f].high;
+    uint32_t low = restrictRec(nodes_[f].low, var, value);
+    uint32_t high = restrictRec(f1, var, value);
+    result = mk(f_var, low, high);
+
+    cacheInsert(OP_RESTRICT, f, var, value, result);
+    return result;
+}
+
+uint32_t BDDManager::existsRec(uint32_t f, uint32_t cube) {
+    // skip the variables of the cube that are above the root of f
+    while ((cube != ONE) && (nodes_[cube].var < nodes_[f].var)) {
+        cube = nodes_[cube].high;
+    }
+    if ((f <= ONE) || (cube == ONE)) {
+        return f;
+    }
+
+    uint32_t result;
+    if (cacheLookup(OP_EXISTS, f, cube, 0, result)) {
+        return result;
+    }
+
+    uint32_t var = nodes_[f].var;
+    uint32_t f1 = nodes_[f].high;
+    if (nodes_[cube].var == var) {
+        uint32_t next_cube = nodes_[cube].high;
+        uint32_t low = existsRec(nodes_[f].low, next_cube);
+        result = (low == ONE) ? ONE : orRec(low, existsRec(f1, next_cube));
+    } else {
+        uint32_t low = existsRec(nodes_[f].low, cube);
+        uint32_t high = existsRec(f1, cube);
+        result = mk(var, low, high);
+    }
+
+    cacheInsert(OP_EXISTS, f, cube, 0, result);
+    return result;
+}
+
+uint32_t BDDManager::andExistsRec(uint32_t f, uint32_t g, uint32_t cube) {
+    if ((f == ZERO) || (g == ZERO)) {
+        return ZERO;
+    }
+    if ((f == ONE) && (g == ONE)) {
+        return ONE;
+    }
+    if ((f == ONE) || (f == g)) {
+        return existsRec(g, cube);
+    }
+    if (g == ONE) {
+        return existsRec(f, cube);
+    }
+    if (f > g) {
+        swap(f, g);
+    }
+
+    uint32_t var = min(nodes_[f].var, nodes_[g].var);
+    while ((cube != ONE) && (nodes_[cube].var < var)) {
+        cube = nodes_[cube].high;
+    }
+    if (cube == ONE) {
+        return andRec(f, g);
+    }
+
+    uint32_t result;
+    if (cacheLookup(OP_AND_EXISTS, f, g, cube, result)) {
+        return result;
+    }
+
+    uint32_t f0 = (nodes_[f].var == var) ? nodes_[f].low : f, f1 = (nodes_[f].var == var) ? nodes_[f].high : f;
+    uint32_t g0 = (nodes_[g].var == var) ? nodes_[g].low : g, g1 = (nodes_[g].var == var) ? nodes_[g].high : g;
+
+    if (nodes_[cube].var == var) {
+        uint32_t next_cube = nodes_[cube].high;
+        uint32_t low = andExistsRec(f0, g0, next_cube);
+        result = (low == ONE) ? ONE : orRec(low, andExistsRec(f1, g1, next_cube));
+    } else {
+        uint32_t low = andExistsRec(f0, g0, cube);
+        uint32_t high = andExistsRec(f1, g1, cube);
+        result = mk(var, low, high);
+    }
+
+    cacheInsert(OP_AND_EXISTS, f, g, cube, result);
+    return result;
+}
+
+void BDDManager::validate(const BDD &f) {
+    if (f.manager_ != this) {
+        throw invalid_argument("The BDD does not belong to this manager");
+    }
+}
+
+void BDDManager::validateVar(int v) {
+    if ((v < 0) || (v >= num_vars_)) {
+        throw out_of_range("Invalid variable index: " + to_string(v));
+    }
+}
@@ -0,0 +1,141 @@
+#ifndef BDD_H
+
+#define BDD_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class BDDManager;
+
+//handle to a node of a reduced ordered binary decision diagram; the nodes referenced by handles
+//are kept by the garbage collector of the manager
+class BDD {
+public:
+    BDD();
+    BDD(const BDD &other);
+    BDD &operator=(const BDD &other);
+    ~BDD();
+
+    bool operator==(const BDD &other) const;
+    bool operator!=(const BDD &other) const;
+
+    BDD operator&(const BDD &other) const;
+    BDD operator|(const BDD &other) const;
+
+    bool isZero() const;
+    bool isOne() const;
+
+private:
+    friend class BDDManager;
+
+    BDDManager *manager_;
+    std::uint32_t node_;
+
+    BDD(BDDManager *manager, std::uint32_t node);
+};
+
+//self-contained BDD package with a unique table, a computed table and a mark and sweep garbage collector;
+//variable i is at level i of the order, so variables with smaller indices are closer to the root
+class BDDManager {
+public:
+    //the manager throws std::length_error when an operation needs more than max_nodes nodes (0 means no limit)
+    BDDManager(int num_vars, std::size_t max_nodes = 0);
+
+    BDDManager(const BDDManager &) = delete;
+    BDDManager &operator=(const BDDManager &) = delete;
+
+    int numVars();
+
+    BDD zero();
+    BDD one();
+    BDD var(int v);
+    BDD nvar(int v);
+
+    BDD apply_and(const BDD &f, const BDD &g);
+    BDD apply_or(const BDD &f, const BDD &g);
+    BDD ite(const BDD &f, const BDD &g, const BDD &h);
+
+    //cofactor of f with the variable v fixed to value
+    BDD restrict(const BDD &f, int v, bool value);
+
+    //relational product: exists cube . (f and g), without building f and g; cube is the conjunction of the
+    //variables to quantify
+    BDD andExists(const BDD &f, const BDD &g, const BDD &cube);
+
+    //replace each variable v by the variable permutation[v]
+    BDD permute(const BDD &f, const std::vector<int> &permutation);
+
+    //number of assignments of vars that satisfy f; f must only depend on variables of vars
+    double satCount(const BDD &f, const std::vector<int> &vars);
+
+    //call callback for each assignment of vars that satisfies f, with the positions in vars of the
+    //variables assigned true, in lexicographic order of the positions; f must only depend on variables of vars
+    void enumerate(const BDD &f, const std::vector<int> &vars,
+        const std::function<void(const std::vector<int> &)> &callback);
+
+    //number of nodes in use and an approximation of the bytes used by the manager
+    std::size_t numNodes();
+    std::size_t memoryUsage();
+
+    //approximate number of bytes used by each node, including the unique and computed tables
+    static std::size_t bytesPerNode();
+
+private:
+    friend class BDD;
+
+    struct Node {
+        std::uint32_t var;
+        std::uint32_t low;
+        std::uint32_t high;
+        std::uint32_t next; // next node in the same bucket of the unique table
+        std::uint32_t ref;  // number of handles that reference the node
+    };
+
+    struct CacheEntry {
+        std::uint32_t op;
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t c;
+        std::uint32_t result;
+    };
+
+    int num_vars_;
+    std::size_t max_nodes_;
+    std::size_t gc_threshold_;
+    std::size_t num_free_;
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> buckets_;
+    std::uint32_t free_list_;
+    std::vector<CacheEntry> cache_;
+
+    void ref(std::uint32_t node);
+    void deref(std::uint32_t node);
+
+    std::uint32_t mk(std::uint32_t var, std::uint32_t low, std::uint32_t high);
+    std::uint32_t hash(std::uint32_t var, std::uint32_t low, std::uint32_t high);
+    void resizeBuckets();
+
+    //the garbage collector only runs at the beginning of the public operations, when every node that
+    //is still needed is referenced by a handle
+    void maybeGarbageCollect();
+    void garbageCollect();
+
+    bool cacheLookup(std::uint32_t op, std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t &result);
+    void cacheInsert(std::uint32_t op, std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t result);
+
+    std::uint32_t andRec(std::uint32_t f, std::uint32_t g);
+    std::uint32_t orRec(std::uint32_t f, std::uint32_t g);
+    std::uint32_t notRec(std::uint32_t f);
+    std::uint32_t iteRec(std::uint32_t f, std::uint32_t g, std::uint32_t h);
+    std::uint32_t restrictRec(std::uint32_t f, std::uint32_t var, std::uint32_t value);
+    std::uint32_t existsRec(std::uint32_t f, std::uint32_t cube);
+    std::uint32_t andExistsRec(std::uint32_t f, std::uint32_t g, std::uint32_t cube);
+
+    void validate(const BDD &f);
+    void validateVar(int v);
+};
+
+#endif /* BDD_H */
@@ -1,4 +1,5 @@
 #include "ConfigurationGraph.h"
+#include "Threads.h"
 #include <exception>
 #include <stdexcept>
 #include <algorithm>
@@ -6,10 +7,13 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <cstdint>
+#include <omp.h>
 
 using namespace std;
 
-ConfigurationGraph::ConfigurationGraph(int num_vertices, int original_num_vertices, vector<vector<int>> &configurations) 
+ConfigurationGraph::ConfigurationGraph(int num_vertices, int original_num_vertices, const vector<vector<int>> &configurations) 
     : num_vertices_(num_vertices), original_num_vertices_(original_num_vertices), configurations_(configurations) {
     if (num_vertices < 0) {
         throw invalid_argument("Invalid number of vertices: " + to_string(num_vertices));
@@ -19,7 +23,7 @@ ConfigurationGraph::ConfigurationGraph(int num_vertices, int original_num_vertic
     adjacency_lists_.resize(num_vertices_);
 }
 
-vector<bool> ConfigurationGraph::findSafeDominatingSets() {
+vector<bool> ConfigurationGraph::findSafeDominatingSets(const function<bool()> &should_stop) {
     //vector to store the safe dominating sets
     vector<bool> is_safe(configurations_.size(), true);
 
@@ -33,6 +37,10 @@ vector<bool> ConfigurationGraph::findSafeDominatingSets() {
         any_changes = false;
 
         for(size_t i = 0; i < configurations_.size(); i++){
+            if (should_stop && should_stop()) {
+                return is_safe;
+            }
+
             //verify if the dominating set is safe
             if(is_safe[i]){
                 
@@ -70,6 +78,164 @@ vector<bool> ConfigurationGraph::findSafeDominatingSets() {
     return is_safe;
 }
 
+vector<bool> ConfigurationGraph::findSafeDominatingSetsParallel(int num_threads, const function<bool()> &should_stop) {
+    num_threads = resolveNumThreads(num_threads);
+
+    const int num_configurations = configurations_.size();
+    const int num_words = (num_configurations + 63) / 64;
+
+    // bitmaps of the safe dominating sets: is_safe is frozen during a round and next_is_safe
+    // receives the removals of the round, which may be done by any thread
+    vector<uint64_t> is_safe(num_words, ~0ULL);
+    vector<atomic<uint64_t>> next_is_safe(num_words);
+    if (num_configurations % 64 != 0) {
+        is_safe[num_words - 1] = (1ULL << (num_configurations % 64)) - 1;
+    }
+
+    auto safe = [&](int i) { return (is_safe[i / 64] >> (i % 64)) & 1ULL; };
+
+    atomic<bool> stopped(false);
+    bool any_changes = true;
+    while (any_changes && !stopped) {
+        for (int w = 0; w < num_words; w++) {
+            next_is_safe[w].store(is_safe[w], memory_order_relaxed);
+        }
+
+        atomic<bool> removed(false);
+
+        #pragma omp parallel num_threads(num_threads)
+        {
+            //vector to store the vertices of the ORIGINAL graph covered by a dominating set and its safe neighbors
+            vector<bool> original_vertices(original_num_vertices_, false);
+            bool local_removed = false;
+
+            #pragma omp for schedule(dynamic, 256)
+            for (int i = 0; i < num_configurations; i++) {
+                // the remaining iterations are skipped, since an OpenMP loop can not be left with break
+                if (stopped || !safe(i)) {
+                    continue;
+                }
+                if (should_stop && should_stop()) {
+                    stopped = true;
+                    continue;
+                }
+
+                for (int vertex : configurations_[i]) {
+                    original_vertices[vertex] = true;
+                }
+
+                for (int neighbor_set : adjacency_lists_[i]) {
+                    if (safe(neighbor_set)) {
+                        for (int vertex : configurations_[neighbor_set]) {
+                            original_vertices[vertex] = true;
+                        }
+                    }
+                }
+
+                if (find(original_vertices.begin(), original_vertices.end(), false) != original_vertices.end()) {
+                    next_is_safe[i / 64].fetch_and(~(1ULL << (i % 64)), memory_order_relaxed);
+                    local_removed = true;
+                }
+
+                fill(original_vertices.begin(), original_vertices.end(), false);
+            }
+
+            if (local_removed) {
+                removed = true;
+            }
+        }
+
+        any_changes = removed;
+        for (int w = 0; w < num_words; w++) {
+            is_safe[w] = next_is_safe[w].load(memory_order_relaxed);
+        }
+    }
+
+    vector<bool> result(num_configurations);
+    for (int i = 0; i < num_configurations; i++) {
+        result[i] = safe(i);
+    }
+    return result;
+}
+
+void ConfigurationGraph::updateSafeDominatingSets(vector<bool> &is_safe, const vector<int> &worklist,
+    const vector<bool> *known_safe, const function<bool()> &should_stop) {
+    // covered[i][v] counts the sets among i and its safe neighbors that have a guard on v; it is computed the
+    // first time that i is checked and then decremented when its neighbors stop being safe, so each check of
+    // a set after the first one only looks at the set that was removed
+    vector<vector<int>> covered(num_vertices_);
+
+    // sets that are not safe anymore and were not subtracted from the counters of their neighbors yet
+    vector<int> removed;
+    vector<bool> is_removed(num_vertices_, false);
+
+    auto remove = [&](int i) {
+        is_safe[i] = false;
+        is_removed[i] = true;
+        removed.push_back(i);
+    };
+
+    // compute the counters of i and return false if a vertex of the ORIGINAL graph is not covered
+    auto count_covered = [&](int i) {
+        covered[i].assign(original_num_vertices_, 0);
+        for (int vertex : configurations_[i]) {
+            covered[i][vertex]++;
+        }
+        for (int neighbor_set : adjacency_lists_[i]) {
+            if (is_safe[neighbor_set] || is_removed[neighbor_set]) {
+                for (int vertex : configurations_[neighbor_set]) {
+                    covered[i][vertex]++;
+                }
+            }
+        }
+        return find(covered[i].begin(), covered[i].end(), 0) == covered[i].end();
+    };
+
+    auto can_change = [&](int i) {
+        return is_safe[i] && ((known_safe == nullptr) || !(*known_safe)[i]);
+    };
+
+    for (int v : worklist) {
+        validateVertex(v);
+        if (should_stop && should_stop()) {
+            return;
+        }
+        if (can_change(v) && covered[v].empty() && !count_covered(v)) {
+            remove(v);
+        }
+    }
+
+    while (!removed.empty()) {
+        if (should_stop && should_stop()) {
+            return;
+        }
+
+        int j = removed.back();
+        removed.pop_back();
+        is_removed[j] = false;
+
+        for (int i : adjacency_lists_[j]) {
+            if (!can_change(i)) {
+                continue;
+            }
+
+            if (covered[i].empty()) {
+                if (!count_covered(i)) {
+                    remove(i);
+                }
+                continue;
+            }
+
+            for (int vertex : configurations_[j]) {
+                if (--covered[i][vertex] == 0) {
+                    remove(i);
+                    break;
+                }
+            }
+        }
+    }
+}
+
 void ConfigurationGraph::printSafeDominatingSets(const vector<vector<int>> &dominating_sets, const vector<bool> &is_safe) {
     cout << "\n-- Safe Dominating Sets of size " << dominating_sets[0].size() << ":\n";
 
@@ -79,9 +245,12 @@ void ConfigurationGraph::printSafeDominatingSets(const vector<vector<int>> &domi
             for (int vertex : dominating_sets[i]) {
                 cout << vertex + 1 << " ";
             }
-            cout << endl;
+            cout << "\n";
         }
     }
+
+    // flushing once instead of once per set
+    cout << flush;
 }
 
 int ConfigurationGraph::numVertices() {
@@ -92,6 +261,49 @@ int ConfigurationGraph::numEdges() {
     return num_edges_;
 }
 
+int ConfigurationGraph::addConfiguration(const vector<int> &configuration) {
+    configurations_.push_back(configuration);
+    adjacency_lists_.emplace_back();
+    return num_vertices_++;
+}
+
+const vector<int> &ConfigurationGraph::configuration(int v) {
+    try {
+        validateVertex(v);
+    } catch (...) {
+        throw_with_nested(runtime_error("Error in operation configuration(int): the vertex " + to_string(v) + " is invalid!"));
+    }
+    return configurations_[v];
+}
+
+const vector<vector<int>> &ConfigurationGraph::configurations() {
+    return configurations_;
+}
+
+const list<int> &ConfigurationGraph::neighbors(int v) {
+    try {
+        validateVertex(v);
+    } catch (...) {
+        throw_with_nested(runtime_error("Error in operation neighbors(int): the vertex " + to_string(v) + " is invalid!"));
+    }
+    return adjacency_lists_[v];
+}
+
+size_t ConfigurationGraph::memoryUsage() {
+    int configuration_size = configurations_.empty() ? 0 : configurations_[0].size();
+    return (size_t) memoryUsage(num_vertices_, configuration_size, num_edges_);
+}
+
+double ConfigurationGraph::memoryUsage(double num_vertices, int configuration_size, double num_edges) {
+    double configurations_size = num_vertices * (sizeof(vector<int>) + configuration_size * sizeof(int));
+
+    // every edge is stored in two lists and each list node keeps the value and two pointers
+    double list_node_size = sizeof(int) + 2 * sizeof(void*);
+    double adjacency_lists_size = num_vertices * sizeof(list<int>) + 2 * num_edges * list_node_size;
+
+    return configurations_size + adjacency_lists_size;
+}
+
 bool ConfigurationGraph::hasEdge(Edge e) {
     try {
         validateEdge(e);
@@ -157,6 +369,41 @@ void ConfigurationGraph::removeEdge(Edge e) {
     }
 }
 
+void ConfigurationGraph::removeEdges(const vector<int> &vertices) {
+    vector<bool> is_removed(num_vertices_, false);
+    for (int v : vertices) {
+        try {
+            validateVertex(v);
+        } catch (...) {
+            throw_with_nested(runtime_error("Error in operation removeEdges(vector<int>): the vertex " + to_string(v) + " is invalid!"));
+        }
+        is_removed[v] = true;
+    }
+
+    // the edges between two removed vertices are counted once
+    vector<bool> is_affected(num_vertices_, false);
+    vector<int> affected;
+    for (int v = 0; v < num_vertices_; v++) {
+        if (!is_removed[v]) {
+            continue;
+        }
+        for (int u : adjacency_lists_[v]) {
+            if (!is_removed[u] || (u > v)) {
+                num_edges_--;
+            }
+            if (!is_removed[u] && !is_affected[u]) {
+                is_affected[u] = true;
+                affected.push_back(u);
+            }
+        }
+        adjacency_lists_[v].clear();
+    }
+
+    for (int u : affected) {
+        adjacency_lists_[u].remove_if([&is_removed](int v) { return is_removed[v]; });
+    }
+}
+
 void ConfigurationGraph::print() {
     for (auto v = 0; v < num_vertices_; v++) {
         cout << v  + 1 << ":"; // vertices are numbered from 1 to n in the file format
@@ -4,24 +4,54 @@
 #include "Edge.h"
 #include <vector> 
 #include <list>
+#include <cstddef>
+#include <functional>
 
 class ConfigurationGraph {
 public:
-    ConfigurationGraph(int num_vertices, int original_num_vertices, std::vector<std::vector<int>> &configurations);
+    ConfigurationGraph(int num_vertices, int original_num_vertices, const std::vector<std::vector<int>> &configurations);
 
-    std::vector<bool> findSafeDominatingSets();
+    //stops early, leaving sets that may not be safe marked as safe, when should_stop returns true
+    std::vector<bool> findSafeDominatingSets(const std::function<bool()> &should_stop = nullptr);
+
+    //same result as findSafeDominatingSets, computed in rounds: in each round, all the dominating sets that are
+    //still safe are checked in parallel against the sets that were safe at the beginning of the round
+    std::vector<bool> findSafeDominatingSetsParallel(int num_threads = 0, const std::function<bool()> &should_stop = nullptr);
+
+    //update is_safe after a local change of the configuration graph: the sets of worklist are checked again and,
+    //when one of them is not safe anymore, its safe neighbors are checked too; every other set marked as safe
+    //must already be covered by itself and its safe neighbors. The sets marked in known_safe (if given) stay
+    //safe and are never checked. When should_stop returns true, the update stops and is_safe is left incomplete
+    void updateSafeDominatingSets(std::vector<bool> &is_safe, const std::vector<int> &worklist,
+        const std::vector<bool> *known_safe = nullptr, const std::function<bool()> &should_stop = nullptr);
 
     void printSafeDominatingSets(const std::vector<std::vector<int>> &dominating_sets, const std::vector<bool> &is_safe);
 
     int numVertices();
     int numEdges();
 
+    //add a configuration with no edges and return its vertex
+    int addConfiguration(const std::vector<int> &configuration);
+
+    const std::vector<int> &configuration(int v);
+    const std::vector<std::vector<int>> &configurations();
+    const std::list<int> &neighbors(int v);
+
+    //approximate number of bytes used by the configurations and the adjacency lists
+    std::size_t memoryUsage();
+
+    //approximate number of bytes used by a configuration graph with the given dimensions
+    static double memoryUsage(double num_vertices, int configuration_size, double num_edges);
+
     bool hasEdge(Edge e);
 
     void insertEdge(Edge e);
 
     void removeEdge(Edge e);
 
+    //remove all the edges of the given vertices, visiting each adjacency list once
+    void removeEdges(const std::vector<int> &vertices);
+
     void print();
 
 private:
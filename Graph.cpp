@@ -1,6 +1,8 @@
 #include "Graph.h"
 #include "BipartiteGraph.h"
 #include "ConfigurationGraph.h"
+#include "TransitionFilter.h"
+#include "Threads.h"
 #include <exception>
 #include <stdexcept>
 #include <algorithm>
@@ -8,6 +10,9 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <utility>
+#include <cstdint>
 #include <omp.h>
 
 using namespace std;
@@ -67,11 +72,11 @@ Graph::Graph(const string& filename) {
     file.close();
 }
 
-vector<vector<int>> Graph::generateDominatingSets(int k) {
+vector<vector<int>> Graph::generateDominatingSets(int k, size_t max_sets, const function<bool()> &should_stop) {
     vector<vector<int>> dominating_sets; // stores the generated dominating sets
     vector<int> dcurrent_set; // stores the current dominating set temporarily
 
-    exploreCombinations(0, k, dcurrent_set, dominating_sets);
+    exploreCombinations(0, k, dcurrent_set, dominating_sets, max_sets, should_stop);
 
     // avoid unnecessary copies
     return move(dominating_sets); // return all the generated dominating sets
@@ -95,7 +100,12 @@ bool Graph::isDominatingSet(vector<int>& set) {
 }
 
 // generate all the dominating sets of size k recursively
-void Graph::exploreCombinations(int current_vertex, int k, vector<int>& current_set, vector<vector<int>>& dominating_sets) {
+void Graph::exploreCombinations(int current_vertex, int k, vector<int>& current_set, vector<vector<int>>& dominating_sets,
+    size_t max_sets, const function<bool()> &should_stop) {
+    if (dominating_sets.size() > max_sets) {
+        return;
+    }
+
     if (((int) current_set.size()) == k) {
         if(isDominatingSet(current_set)) {
             dominating_sets.push_back(current_set);
@@ -103,14 +113,36 @@ void Graph::exploreCombinations(int current_vertex, int k, vector<int>& current_
         return;
     }
 
+    // checked before the leaves, so a stop only costs one call per remaining child along the current path
+    if (should_stop && should_stop()) {
+        return;
+    }
+
     for (int v = current_vertex; v < num_vertices_; v++) {
         current_set.push_back(v);
-        exploreCombinations(v + 1, k, current_set, dominating_sets);
+        exploreCombinations(v + 1, k, current_set, dominating_sets, max_sets, should_stop);
         current_set.pop_back();
     }
 }
 
-bool Graph::isGuardTransition(vector<int> &dominating_set_1, vector<int> &dominating_set_2, bool print_transition) {
+bool Graph::isGuardTransition(const vector<int> &dominating_set_1, const vector<int> &dominating_set_2, bool print_transition) {
+    vector<int> destinations;
+    if (!findGuardMoves(dominating_set_1, dominating_set_2, destinations)) {
+        return false;
+    }
+
+    if (print_transition) {
+        cout << "Guard transition:\n";
+        for (size_t g = 0; g < dominating_set_1.size(); g++) {
+            cout << "Guard on " << (dominating_set_1[g] + 1) << " moves to " << (destinations[g] + 1) << "\n";
+        }
+        cout << flush;
+    }
+
+    return true;
+}
+
+bool Graph::findGuardMoves(const vector<int> &dominating_set_1, const vector<int> &dominating_set_2, vector<int> &destinations) {
     if (dominating_set_1.size() != dominating_set_2.size()) {
         return false;
     }
@@ -141,31 +173,38 @@ bool Graph::isGuardTransition(vector<int> &dominating_set_1, vector<int> &domina
     vector<int> match(2 * dominating_set_size);
     int max_matching_size = bipartite_graph.maxMatching(match);
 
-    if (max_matching_size == dominating_set_size) {
-        if (print_transition) {
-            cout << "Guard transition:" << endl;
-            for (int v = dominating_set_size; v < (2 * dominating_set_size); v++) {
-                if (match[v] >= 0) {
-                    cout << "Guard on " << (dominating_set_1[match[v]] + 1) <<
-                        " moves to " <<
-                        (dominating_set_2[v - dominating_set_size] + 1) <<
-                        endl;
-                }
-            }
-        }
-
-        return true;
+    if (max_matching_size != dominating_set_size) {
+        return false;
     }
 
-    return false;
+    destinations.assign(dominating_set_size, -1);
+    for (int v = dominating_set_size; v < (2 * dominating_set_size); v++) {
+        destinations[match[v]] = dominating_set_2[v - dominating_set_size];
+    }
+    return true;
 }
 
-ConfigurationGraph Graph::generateConfigurationGraph(int k, const vector<vector<int>>& dominating_sets) {
-    vector<vector<int>> dominating_configs = dominating_sets;
+ConfigurationGraph Graph::generateConfigurationGraph(int k, const vector<vector<int>>& dominating_sets,
+    int num_threads, const function<bool()> &should_stop, TransitionFilterStats *filter_stats, size_t max_edges) {
+    const vector<vector<int>> &dominating_configs = dominating_sets;
 
     ConfigurationGraph configuration_graph(dominating_configs.size(), num_vertices_, dominating_configs);
 
-    #pragma omp parallel
+    num_threads = resolveNumThreads(num_threads);
+
+    // the edges found by each thread are kept apart and inserted after the parallel region,
+    // since the adjacency lists of the configuration graph can not be modified concurrently
+    vector<vector<pair<int, int>>> thread_edges(num_threads);
+    atomic<bool> stopped(false);
+    atomic<size_t> num_edges(0);
+
+    // the pairs of dominating sets that the filter rejects (a quarter to a third of them on the sample graphs) skip
+    // the maximum matching
+    TransitionFilter transition_filter(*this, dominating_configs);
+    atomic<size_t> num_candidates(0);
+    atomic<size_t> num_rejected(0);
+
+    #pragma omp parallel num_threads(num_threads)
     {
         // get the number of threads and the thread id
         int num_threads = omp_get_num_threads();
@@ -176,41 +215,168 @@ ConfigurationGraph Graph::generateConfigurationGraph(int k, const vector<vector<
         int local_start = thread_id * chunk;
         int local_end = min(local_start + chunk, (int)dominating_configs.size());
 
+        const int block_size = 1024;
+        vector<uint64_t> private_masks;
+        vector<int> survivors;
+        size_t local_candidates = 0;
+        size_t local_rejected = 0;
+
         // iterate over the local range of dominating sets
         for (int i = local_start; i < local_end; i++) {
-            for (int j = i + 1; j < (int) dominating_configs.size(); j++) {
-                if (isGuardTransition(dominating_configs[i], dominating_configs[j], false)) {
-                    configuration_graph.insertEdge(Edge(i, j));
+            if (stopped || (should_stop && should_stop())) {
+                stopped = true;
+                break;
+            }
+
+            transition_filter.privateNeighborhoods(i, private_masks);
+
+            // the stop is also checked for each block, since a dominating set can have thousands of candidates
+            for (int block_start = i + 1; block_start < (int) dominating_configs.size(); block_start += block_size) {
+                if (stopped || (should_stop && should_stop())) {
+                    stopped = true;
+                    break;
                 }
+
+                int block_end = min(block_start + block_size, (int) dominating_configs.size());
+                int num_survivors = transition_filter.filter(private_masks, block_start, block_end, survivors);
+
+                local_candidates += block_end - block_start;
+                local_rejected += (block_end - block_start) - num_survivors;
+
+                for (int s = 0; s < num_survivors; s++) {
+                    int j = survivors[s];
+                    if (isGuardTransition(dominating_configs[i], dominating_configs[j], false)) {
+                        thread_edges[thread_id].push_back(make_pair(i, j));
+
+                        // the buffers stop growing as soon as the limit of transitions is exceeded
+                        if (++num_edges > max_edges) {
+                            stopped = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        num_candidates += local_candidates;
+        num_rejected += local_rejected;
+    }
+
+    if (filter_stats != nullptr) {
+        filter_stats->num_candidates += num_candidates;
+        filter_stats->num_rejected += num_rejected;
+    }
+
+    // inserting the edges can take as long as finding them, so should_stop is checked here too; an incomplete
+    // configuration graph is discarded by the caller, so the remaining edges are not inserted after a stop
+    size_t num_inserted = 0;
+    for (auto &edges : thread_edges) {
+        for (auto &e : edges) {
+            if ((num_inserted++ % 4096 == 0) && should_stop && should_stop()) {
+                return configuration_graph;
             }
+            configuration_graph.insertEdge(Edge(e.first, e.second));
         }
     }
 
     return move(configuration_graph);
 }
 
-void Graph::findMinimumGuardSet(){
-    int max_k = num_vertices_; // the maximum size of a dominating set is the number of vertices in the graph
-    vector<vector<int>> dominating_sets; // stores the generated dominating sets
-
+vector<bool> Graph::findSafeDominatingSetsImplicit(const vector<vector<int>> &dominating_sets,
+    int num_threads, const function<bool()> &should_stop, TransitionFilterStats *filter_stats) {
+    num_threads = resolveNumThreads(num_threads);
+
+    const int num_configurations = dominating_sets.size();
+
+    TransitionFilter transition_filter(*this, dominating_sets);
+    atomic<size_t> num_candidates(0);
+    atomic<size_t> num_rejected(0);
+
+    // as in ConfigurationGraph::findSafeDominatingSetsParallel, each round checks the dominating sets
+    // against the ones that were safe at the beginning of the round
+    vector<char> is_safe(num_configurations, true);
+    vector<char> next_is_safe(num_configurations, true);
+    atomic<bool> stopped(false);
+
+    bool any_changes = true;
+    while (any_changes && !stopped) {
+        atomic<bool> removed(false);
+
+        #pragma omp parallel num_threads(num_threads)
+        {
+            const int block_size = 1024;
+            vector<uint64_t> private_masks;
+            vector<int> survivors;
+            vector<bool> original_vertices(num_vertices_);
+            size_t local_candidates = 0;
+            size_t local_rejected = 0;
+
+            #pragma omp for schedule(dynamic, 16)
+            for (int i = 0; i < num_configurations; i++) {
+                if (!is_safe[i] || stopped) {
+                    continue;
+                }
+                if (should_stop && should_stop()) {
+                    stopped = true;
+                    continue;
+                }
 
-    // iterating over all possible sizes of dominating sets
-    for (int k = 1; k <= max_k; k++) {
-        dominating_sets = generateDominatingSets(k);
+                fill(original_vertices.begin(), original_vertices.end(), false);
+                int num_uncovered = num_vertices_;
+                for (int vertex : dominating_sets[i]) {
+                    original_vertices[vertex] = true;
+                    num_uncovered--;
+                }
 
-        //generate the configuration graph of the dominating sets of size k
-        ConfigurationGraph configuration_graph = generateConfigurationGraph(k, dominating_sets);
+                transition_filter.privateNeighborhoods(i, private_masks);
+
+                // look for safe neighbors only until every vertex of the original graph is covered
+                for (int block_start = 0; (block_start < num_configurations) && (num_uncovered > 0); block_start += block_size) {
+                    int block_end = min(block_start + block_size, num_configurations);
+                    int num_survivors = transition_filter.filter(private_masks, block_start, block_end, survivors);
+
+                    local_candidates += block_end - block_start;
+                    local_rejected += (block_end - block_start) - num_survivors;
+
+                    for (int s = 0; (s < num_survivors) && (num_uncovered > 0); s++) {
+                        int j = survivors[s];
+                        if ((j == i) || !is_safe[j]) {
+                            continue;
+                        }
+
+                        bool covers_new_vertex = any_of(dominating_sets[j].begin(), dominating_sets[j].end(),
+                            [&](int vertex) { return !original_vertices[vertex]; });
+
+                        if (covers_new_vertex && isGuardTransition(dominating_sets[i], dominating_sets[j], false)) {
+                            for (int vertex : dominating_sets[j]) {
+                                if (!original_vertices[vertex]) {
+                                    original_vertices[vertex] = true;
+                                    num_uncovered--;
+                                }
+                            }
+                        }
+                    }
+                }
 
-        // generate the safe dominating sets of the configuration graph
-        vector<bool> safe_dominating_sets = configuration_graph.findSafeDominatingSets();
+                if (num_uncovered > 0) {
+                    next_is_safe[i] = false;
+                    removed = true;
+                }
+            }
 
-        // if there is a safe dominating set, then it is the minimum guard set
-        if (any_of(safe_dominating_sets.begin(), safe_dominating_sets.end(), [](bool b) { return b; })) {
-            configuration_graph.printSafeDominatingSets(dominating_sets, safe_dominating_sets);
-            cout << "\n-- Minimum guard set size: " << k << endl;
-            return;
+            num_candidates += local_candidates;
+            num_rejected += local_rejected;
         }
+
+        any_changes = removed;
+        is_safe = next_is_safe;
     }
+
+    if (filter_stats != nullptr) {
+        filter_stats->num_candidates += num_candidates;
+        filter_stats->num_rejected += num_rejected;
+    }
+
+    return vector<bool>(is_safe.begin(), is_safe.end());
 }
 
 int Graph::numVertices() {
@@ -237,6 +403,19 @@ bool Graph::hasEdge(Edge e) {
     return false;
 }
 
+vector<int> Graph::closedNeighborhood(int v) {
+    try {
+        validateVertex(v);
+    } catch (...) {
+        throw_with_nested(runtime_error("Error in operation closedNeighborhood(int):"
+            " the vertex " + to_string(v) + " is invalid!"));
+    }
+
+    vector<int> neighborhood(adjacency_lists_[v].begin(), adjacency_lists_[v].end());
+    neighborhood.push_back(v);
+    return neighborhood;
+}
+
 void Graph::insertEdge(Edge e) {
     try {
         validateEdge(e);
@@ -296,6 +475,26 @@ void Graph::print() {
     }
 }
 
+void Graph::save(const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Error opening file: " + filename);
+    }
+
+    file << "p edge " << num_vertices_ << " " << num_edges_ << "\n";
+    for (auto v = 0; v < num_vertices_; v++) {
+        for (auto u : adjacency_lists_[v]) {
+            if (v < u) { // each edge is written only once
+                file << "e " << v + 1 << " " << u + 1 << "\n";
+            }
+        }
+    }
+
+    if (!file) {
+        throw runtime_error("Error writing file: " + filename);
+    }
+}
+
 void Graph::validateVertex(int v) {
     if ((v < 0) || (v >= num_vertices_)) {
         throw out_of_range("Invalid vertex index: " + to_string(v));
@@ -4,8 +4,12 @@
 
 #include "Edge.h"
 #include "ConfigurationGraph.h"
+#include "TransitionFilter.h"
 #include <vector>
 #include <list>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
 
 class Graph {
 public:
@@ -18,14 +22,38 @@ public:
 
     bool isDominatingSet(std::vector<int>& set);
 
-    std::vector<std::vector<int>> generateDominatingSets(int k);
-
-    void exploreCombinations(int current_vertex ,int k, std::vector<int>& current_set, std::vector<std::vector<int>>& dominating_sets);
-
-    bool isGuardTransition(std::vector<int> &dominating_set_1, std::vector<int> &dominating_set_2, bool print_transition);
-
-    ConfigurationGraph generateConfigurationGraph(int k, const std::vector<std::vector<int>> &dominating_sets);
-
+    //the generation stops when more than max_sets dominating sets are found, so the caller can detect
+    //that the limit was exceeded by checking if the result has max_sets + 1 sets; it also stops early,
+    //leaving the result incomplete, when should_stop returns true
+    std::vector<std::vector<int>> generateDominatingSets(int k, std::size_t max_sets = SIZE_MAX,
+        const std::function<bool()> &should_stop = nullptr);
+
+    void exploreCombinations(int current_vertex ,int k, std::vector<int>& current_set, std::vector<std::vector<int>>& dominating_sets,
+        std::size_t max_sets = SIZE_MAX, const std::function<bool()> &should_stop = nullptr);
+
+    bool isGuardTransition(const std::vector<int> &dominating_set_1, const std::vector<int> &dominating_set_2, bool print_transition);
+
+    //same test as isGuardTransition; when there is a transition, destinations[g] is the vertex of dominating_set_2
+    //to which the guard on dominating_set_1[g] moves
+    bool findGuardMoves(const std::vector<int> &dominating_set_1, const std::vector<int> &dominating_set_2,
+        std::vector<int> &destinations);
+
+    //the construction uses num_threads threads (0 uses the OpenMP default) and stops early, leaving the
+    //configuration graph incomplete, when should_stop returns true; the pairs of dominating sets go through
+    //a TransitionFilter before isGuardTransition, and its counters are added to filter_stats if it is given.
+    //The construction also stops when more than max_edges transitions are found, so the caller can detect
+    //that the limit was exceeded by checking if the configuration graph has more than max_edges edges
+    ConfigurationGraph generateConfigurationGraph(int k, const std::vector<std::vector<int>> &dominating_sets,
+        int num_threads = 0, const std::function<bool()> &should_stop = nullptr,
+        TransitionFilterStats *filter_stats = nullptr, std::size_t max_edges = SIZE_MAX);
+
+    //find the safe dominating sets without building the configuration graph: the transitions of each
+    //dominating set are computed again in every round, which takes more time but only O(|D|) memory
+    std::vector<bool> findSafeDominatingSetsImplicit(const std::vector<std::vector<int>> &dominating_sets,
+        int num_threads = 0, const std::function<bool()> &should_stop = nullptr,
+        TransitionFilterStats *filter_stats = nullptr);
+
+    //print the safe dominating sets of the minimum size found by a Solver (defined in Solver.cpp)
     void findMinimumGuardSet();
 
     int numVertices();
@@ -33,6 +61,9 @@ public:
 
     bool hasEdge(Edge e);
 
+    //v and its neighbors
+    std::vector<int> closedNeighborhood(int v);
+
     //insert an edge in the graph if the edge does not exist in the graph and is not a loop
     void insertEdge(Edge e);
 
@@ -40,6 +71,9 @@ public:
     void removeEdge(Edge e);
 
     void print();
+
+    //write the graph to a file in the same format read by the constructor (vertices numbered from 1 to n)
+    void save(const std::string& filename);
 private:
     //attributes of the class Graph will have the suffix _ (underscore) to differentiate from the parameters
     int num_vertices_;
@@ -0,0 +1,437 @@
+#include "IncrementalSolver.h"
+#include "Threads.h"
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <functional>
+#include <cstdint>
+#include <atomic>
+#include <omp.h>
+
+using namespace std;
+
+IncrementalSolver::Level::Level(int k, int num_vertices, ConfigurationGraph &&graph)
+    : k(k), configuration_graph(move(graph)), containing(num_vertices) {
+    int num_configurations = configuration_graph.numVertices();
+    is_dominating.assign(num_configurations, true);
+    is_safe.assign(num_configurations, false);
+
+    for (int i = 0; i < num_configurations; i++) {
+        const vector<int> &configuration = configuration_graph.configuration(i);
+        index[configuration] = i;
+        for (int v : configuration) {
+            containing[v].push_back(i);
+        }
+    }
+}
+
+IncrementalSolver::IncrementalSolver(Graph &graph, const SolverOptions &options)
+    : graph_(graph), options_(options), deadline_(options.time_limit) {
+    Solver::validateOptions(graph, options);
+}
+
+SolverResult IncrementalSolver::solve() {
+    SolverResult result;
+    deadline_.start();
+    upper_.reset();
+    lower_.reset();
+
+    for (int k = options_.starting_k; k <= graph_.numVertices(); k++) {
+        unique_ptr<Level> level = buildLevel(k, result);
+        if (!level) {
+            return finish(result);
+        }
+
+        if (numSafe(*level) > 0) {
+            upper_ = move(level);
+            break;
+        }
+        lower_ = move(level);
+    }
+
+    return finish(result);
+}
+
+SolverResult IncrementalSolver::insertEdge(Edge e) {
+    return update(e, true);
+}
+
+SolverResult IncrementalSolver::removeEdge(Edge e) {
+    return update(e, false);
+}
+
+SolverResult IncrementalSolver::update(Edge e, bool inserted) {
+    SolverResult result;
+    deadline_.start();
+
+    if ((e.v1 == e.v2) || (graph_.hasEdge(e) == inserted)) {
+        return finish(result);
+    }
+
+    if (inserted) {
+        graph_.insertEdge(e);
+    } else {
+        graph_.removeEdge(e);
+    }
+
+    // there is nothing to update if the last solve did not finish
+    if (!upper_) {
+        return solve();
+    }
+
+    if (inserted) {
+        // the safe sets can only grow, so k goes down while the level below it has safe sets; the level
+        // below is updated first, since the level of k is not needed anymore if k goes down
+        if (lower_) {
+            insertEdgeInLevel(*lower_, e, result);
+        } else if (upper_->k > 1) {
+            lower_ = buildLevel(upper_->k - 1, result);
+        }
+        if (result.status == SolverStatus::TimeLimitExceeded) {
+            return finish(result);
+        }
+
+        if (!lower_ || (numSafe(*lower_) == 0)) {
+            insertEdgeInLevel(*upper_, e, result);
+            if (result.status == SolverStatus::TimeLimitExceeded) {
+                return finish(result);
+            }
+        }
+
+        while (lower_ && (numSafe(*lower_) > 0)) {
+            upper_ = move(lower_);
+            if (upper_->k > 1) {
+                lower_ = buildLevel(upper_->k - 1, result);
+            }
+        }
+    } else {
+        // the safe sets can only shrink, so k goes up while its level has no safe sets
+        removeEdgeFromLevel(*upper_, e, result);
+        if (lower_ && (result.status != SolverStatus::TimeLimitExceeded)) {
+            removeEdgeFromLevel(*lower_, e, result);
+        }
+        if (result.status == SolverStatus::TimeLimitExceeded) {
+            return finish(result);
+        }
+
+        while (upper_ && (numSafe(*upper_) == 0)) {
+            lower_ = move(upper_);
+            upper_ = buildLevel(lower_->k + 1, result);
+        }
+    }
+
+    return finish(result);
+}
+
+unique_ptr<IncrementalSolver::Level> IncrementalSolver::buildLevel(int k, SolverResult &result) {
+    chrono::milliseconds start = deadline_.elapsed();
+
+    vector<vector<int>> dominating_sets = graph_.generateDominatingSets(k, SIZE_MAX, [this]() { return deadline_.exceeded(); });
+    if (deadline_.exceeded()) {
+        result.status = SolverStatus::TimeLimitExceeded;
+        return nullptr;
+    }
+
+    ConfigurationGraph configuration_graph = graph_.generateConfigurationGraph(k, dominating_sets,
+        options_.num_threads, [this]() { return deadline_.exceeded(); });
+    if (deadline_.exceeded()) {
+        result.status = SolverStatus::TimeLimitExceeded;
+        return nullptr;
+    }
+
+    unique_ptr<Level> level(new Level(k, graph_.numVertices(), move(configuration_graph)));
+    level->is_safe = options_.parallel_elimination ?
+        level->configuration_graph.findSafeDominatingSetsParallel(options_.num_threads, [this]() { return deadline_.exceeded(); }) :
+        level->configuration_graph.findSafeDominatingSets([this]() { return deadline_.exceeded(); });
+    if (deadline_.exceeded()) {
+        result.status = SolverStatus::TimeLimitExceeded;
+        return nullptr;
+    }
+
+    result.iterations.push_back(levelStats(*level, start));
+    return level;
+}
+
+void IncrementalSolver::insertEdgeInLevel(Level &level, Edge e, SolverResult &result) {
+    chrono::milliseconds start = deadline_.elapsed();
+    ConfigurationGraph &configuration_graph = level.configuration_graph;
+
+    // a set that only dominates the graph with the new edge has a guard on one endpoint and no guard next
+    // to the other endpoint, which was the only vertex it did not dominate
+    vector<int> new_configurations;
+    for (int i = 0; i < 2; i++) {
+        int guarded = (i == 0) ? e.v1 : e.v2;
+        int other = (i == 0) ? e.v2 : e.v1;
+
+        vector<bool> forbidden(graph_.numVertices(), false);
+        for (int u : graph_.closedNeighborhood(other)) {
+            forbidden[u] = (u != guarded);
+        }
+
+        vector<vector<int>> sets = dominatingSetsWith(level.k, guarded, forbidden);
+        if (deadline_.exceeded()) {
+            result.status = SolverStatus::TimeLimitExceeded;
+            return;
+        }
+
+        for (auto &set : sets) {
+            auto it = level.index.find(set);
+            if (it == level.index.end()) {
+                int c = configuration_graph.addConfiguration(set);
+                level.index[set] = c;
+                level.is_dominating.push_back(true);
+                level.is_safe.push_back(false);
+                for (int v : set) {
+                    level.containing[v].push_back(c);
+                }
+                new_configurations.push_back(c);
+            } else if (!level.is_dominating[it->second]) {
+                level.is_dominating[it->second] = true;
+                new_configurations.push_back(it->second);
+            }
+        }
+    }
+
+    // the new sets may have transitions to any set, and the other new transitions move a guard along the new
+    // edge, from a set with a guard on one endpoint to a set with a guard on the other endpoint
+    int num_configurations = configuration_graph.numVertices();
+    vector<bool> is_new(num_configurations, false);
+    vector<int> sources = new_configurations;
+    for (int c : new_configurations) {
+        is_new[c] = true;
+    }
+    for (int i : level.containing[e.v1]) {
+        if (level.is_dominating[i] && !is_new[i]) {
+            sources.push_back(i);
+        }
+    }
+
+    TransitionFilter transition_filter(graph_, configuration_graph.configurations());
+
+    // as in Graph::generateConfigurationGraph, the transitions found by each thread are inserted after the parallel region
+    int num_threads = resolveNumThreads(options_.num_threads);
+    vector<vector<pair<int, int>>> thread_edges(num_threads);
+    atomic<bool> stopped(false);
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        vector<uint64_t> private_masks;
+        vector<int> survivors;
+        vector<char> is_neighbor(num_configurations, false);
+        int thread_id = omp_get_thread_num();
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int s = 0; s < (int) sources.size(); s++) {
+            // the remaining iterations are skipped, since an OpenMP loop can not be left with break
+            if (stopped) {
+                continue;
+            }
+            if (deadline_.exceeded()) {
+                stopped = true;
+                continue;
+            }
+
+            int i = sources[s];
+            transition_filter.privateNeighborhoods(i, private_masks);
+            int num_survivors = transition_filter.filter(private_masks, 0, num_configurations, survivors);
+            for (int j : configuration_graph.neighbors(i)) {
+                is_neighbor[j] = true;
+            }
+
+            for (int t = 0; t < num_survivors; t++) {
+                int j = survivors[t];
+                if ((j == i) || !level.is_dominating[j]) {
+                    continue;
+                }
+
+                // each pair of new sets is checked once, and a new set is never checked by an old one
+                const vector<int> &set = configuration_graph.configuration(j);
+                if (is_new[i] ? (is_new[j] && (j < i)) : (is_new[j] || !binary_search(set.begin(), set.end(), e.v2))) {
+                    continue;
+                }
+
+                if (!is_neighbor[j] && graph_.isGuardTransition(configuration_graph.configuration(i), set, false)) {
+                    thread_edges[thread_id].push_back(make_pair(i, j));
+                }
+            }
+
+            for (int j : configuration_graph.neighbors(i)) {
+                is_neighbor[j] = false;
+            }
+        }
+    }
+
+    if (stopped) {
+        result.status = SolverStatus::TimeLimitExceeded;
+        return;
+    }
+
+    vector<int> touched = new_configurations;
+    for (auto &edges : thread_edges) {
+        for (auto &edge : edges) {
+            configuration_graph.insertEdge(Edge(edge.first, edge.second));
+            touched.push_back(edge.first);
+            touched.push_back(edge.second);
+        }
+    }
+
+    // the safe sets stay safe; an unsafe set can only become safe together with the unsafe sets connected to it,
+    // so the sets connected to the changed ones are assumed safe and the fixpoint is computed again among them
+    vector<bool> was_safe = level.is_safe;
+    vector<int> candidates;
+    for (int c : touched) {
+        if (level.is_dominating[c] && !level.is_safe[c]) {
+            level.is_safe[c] = true;
+            candidates.push_back(c);
+        }
+    }
+    for (size_t next = 0; next < candidates.size(); next++) {
+        for (int j : configuration_graph.neighbors(candidates[next])) {
+            if (level.is_dominating[j] && !level.is_safe[j]) {
+                level.is_safe[j] = true;
+                candidates.push_back(j);
+            }
+        }
+    }
+    configuration_graph.updateSafeDominatingSets(level.is_safe, candidates, &was_safe, [this]() { return deadline_.exceeded(); });
+    if (deadline_.exceeded()) {
+        result.status = SolverStatus::TimeLimitExceeded;
+        return;
+    }
+
+    result.iterations.push_back(levelStats(level, start));
+}
+
+void IncrementalSolver::removeEdgeFromLevel(Level &level, Edge e, SolverResult &result) {
+    chrono::milliseconds start = deadline_.elapsed();
+    ConfigurationGraph &configuration_graph = level.configuration_graph;
+    vector<int> worklist;
+
+    // only the sets with a guard on an endpoint can stop dominating the graph; they keep their vertex, with no edges
+    vector<int> not_dominating;
+    for (int endpoint : {e.v1, e.v2}) {
+        for (int i : level.containing[endpoint]) {
+            vector<int> set = configuration_graph.configuration(i);
+            if (!level.is_dominating[i] || graph_.isDominatingSet(set)) {
+                continue;
+            }
+
+            level.is_dominating[i] = false;
+            level.is_safe[i] = false;
+            not_dominating.push_back(i);
+            worklist.insert(worklist.end(), configuration_graph.neighbors(i).begin(), configuration_graph.neighbors(i).end());
+        }
+    }
+    configuration_graph.removeEdges(not_dominating);
+
+    // the transitions that can be lost are the ones that moved a guard along the edge
+    for (int i : level.containing[e.v1]) {
+        if (deadline_.exceeded()) {
+            result.status = SolverStatus::TimeLimitExceeded;
+            return;
+        }
+        if (!level.is_dominating[i]) {
+            continue;
+        }
+
+        vector<int> neighbors(configuration_graph.neighbors(i).begin(), configuration_graph.neighbors(i).end());
+        for (int j : neighbors) {
+            const vector<int> &set = configuration_graph.configuration(j);
+            if (binary_search(set.begin(), set.end(), e.v2) &&
+                !graph_.isGuardTransition(configuration_graph.configuration(i), set, false)) {
+                configuration_graph.removeEdge(Edge(i, j));
+                worklist.push_back(i);
+                worklist.push_back(j);
+            }
+        }
+    }
+
+    configuration_graph.updateSafeDominatingSets(level.is_safe, worklist, nullptr, [this]() { return deadline_.exceeded(); });
+    if (deadline_.exceeded()) {
+        result.status = SolverStatus::TimeLimitExceeded;
+        return;
+    }
+
+    result.iterations.push_back(levelStats(level, start));
+}
+
+vector<vector<int>> IncrementalSolver::dominatingSetsWith(int k, int v, const vector<bool> &forbidden) {
+    vector<vector<int>> dominating_sets;
+    vector<int> others; // the other k - 1 vertices of the set
+    vector<int> set;
+
+    function<void(int)> explore = [&](int current_vertex) {
+        if ((int) others.size() == k - 1) {
+            set = others;
+            set.insert(upper_bound(set.begin(), set.end(), v), v);
+            if (graph_.isDominatingSet(set)) {
+                dominating_sets.push_back(set);
+            }
+            return;
+        }
+
+        // checked before the leaves, as in Graph::exploreCombinations
+        if (deadline_.exceeded()) {
+            return;
+        }
+
+        for (int u = current_vertex; u < graph_.numVertices(); u++) {
+            if ((u != v) && !forbidden[u]) {
+                others.push_back(u);
+                explore(u + 1);
+                others.pop_back();
+            }
+        }
+    };
+
+    explore(0);
+    return dominating_sets;
+}
+
+int IncrementalSolver::numSafe(const Level &level) {
+    return count(level.is_safe.begin(), level.is_safe.end(), true);
+}
+
+SolverIterationStats IncrementalSolver::levelStats(Level &level, chrono::milliseconds start) {
+    SolverIterationStats stats;
+    stats.k = level.k;
+    stats.num_dominating_sets = count(level.is_dominating.begin(), level.is_dominating.end(), true);
+    stats.num_transitions = level.configuration_graph.numEdges();
+    stats.num_safe_dominating_sets = numSafe(level);
+    stats.memory_bytes = level.configuration_graph.memoryUsage();
+    stats.elapsed = deadline_.elapsed() - start;
+    return stats;
+}
+
+SolverResult IncrementalSolver::finish(SolverResult &result) {
+    if (result.status == SolverStatus::TimeLimitExceeded) {
+        upper_.reset();
+        lower_.reset();
+    }
+
+    if (upper_) {
+        // the dominating sets are returned in the order of Graph::generateDominatingSets, as by the solver
+        vector<pair<vector<int>, bool>> sets;
+        for (int i = 0; i < upper_->configuration_graph.numVertices(); i++) {
+            if (upper_->is_dominating[i]) {
+                sets.push_back(make_pair(upper_->configuration_graph.configuration(i), (bool) upper_->is_safe[i]));
+            }
+        }
+        sort(sets.begin(), sets.end());
+
+        result.minimum_k = upper_->k;
+        for (auto &set : sets) {
+            result.dominating_sets.push_back(set.first);
+            result.is_safe.push_back(set.second);
+            if (set.second) {
+                result.safe_dominating_sets.push_back(set.first);
+            }
+        }
+        result.num_safe_dominating_sets = numSafe(*upper_);
+    }
+
+    result.elapsed = deadline_.elapsed();
+    return result;
+}
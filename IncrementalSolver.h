@@ -0,0 +1,74 @@
+#ifndef INCREMENTALSOLVER_H
+
+#define INCREMENTALSOLVER_H
+
+#include "Graph.h"
+#include "Edge.h"
+#include "ConfigurationGraph.h"
+#include "Solver.h"
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+
+//solver that keeps the dominating sets, the configuration graph and the safe dominating sets of the minimum
+//number of guards k (and of k - 1, which has no safe set) between calls, so that after an edge is inserted or
+//removed only the dominating sets and the transitions that contain its endpoints are checked again
+//
+//an edge insertion never makes a safe set unsafe, so k can only decrease, and an edge removal never makes an
+//unsafe set safe, so k can only increase; the other numbers of guards are solved from scratch when needed.
+//only num_threads, time_limit, starting_k and parallel_elimination of the options are used
+class IncrementalSolver {
+public:
+    IncrementalSolver(Graph &graph, const SolverOptions &options = SolverOptions());
+
+    //solve from scratch, keeping the state for the next changes
+    SolverResult solve();
+
+    //change the graph and update the solution; an edge that is already in the graph (or missing, for
+    //removeEdge) or a loop changes nothing
+    SolverResult insertEdge(Edge e);
+    SolverResult removeEdge(Edge e);
+
+private:
+    //dominating sets and configuration graph of one number of guards; the vertices of the configuration graph
+    //are kept when they stop being dominating sets, with no edges, so their indices do not change
+    struct Level {
+        int k;
+        ConfigurationGraph configuration_graph;
+        std::vector<bool> is_dominating;
+        std::vector<bool> is_safe;
+        std::map<std::vector<int>, int> index;
+        std::vector<std::vector<int>> containing; // containing[v] has the configurations with a guard on v
+
+        Level(int k, int num_vertices, ConfigurationGraph &&graph);
+    };
+
+    Graph &graph_;
+    SolverOptions options_;
+    SolverDeadline deadline_;
+
+    //the level of the minimum number of guards and the level below it (null when k = 1 or not built yet)
+    std::unique_ptr<Level> upper_;
+    std::unique_ptr<Level> lower_;
+
+    SolverResult update(Edge e, bool inserted);
+
+    //build a level from scratch; returns null if the time limit is exceeded
+    std::unique_ptr<Level> buildLevel(int k, SolverResult &result);
+
+    //update a level after a change of the graph; when the time limit is exceeded, the status of result is set
+    //to TimeLimitExceeded and the level is left incomplete
+    void insertEdgeInLevel(Level &level, Edge e, SolverResult &result);
+    void removeEdgeFromLevel(Level &level, Edge e, SolverResult &result);
+
+    //k-subsets with a guard on v and no guard on the vertices of forbidden that dominate the graph; the search
+    //stops early when the time limit is exceeded
+    std::vector<std::vector<int>> dominatingSetsWith(int k, int v, const std::vector<bool> &forbidden);
+
+    int numSafe(const Level &level);
+    SolverIterationStats levelStats(Level &level, std::chrono::milliseconds start);
+    SolverResult finish(SolverResult &result);
+};
+
+#endif /* INCREMENTALSOLVER_H */
@@ -0,0 +1,239 @@
+#include "InstanceGenerator.h"
+#include "Edge.h"
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <string>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+namespace {
+
+void validateNumVertices(int num_vertices) {
+    if (num_vertices <= 0) {
+        throw invalid_argument("Invalid number of vertices: " + to_string(num_vertices));
+    }
+}
+
+void validateDimension(int dim) {
+    if (dim <= 0) {
+        throw invalid_argument("Invalid grid dimension: " + to_string(dim));
+    }
+}
+
+// build the Cayley graph of a group with elements 0, ..., order - 1 (0 is the identity)
+Graph cayleyGraph(int order, const function<int(int, int)> &multiply, const vector<int> &generators) {
+    Graph g(order);
+    for (int element = 0; element < order; element++) {
+        for (int generator : generators) {
+            g.insertEdge(Edge(element, multiply(element, generator)));
+        }
+    }
+    return g;
+}
+
+// choose num_generators distinct elements different from the identity such that no chosen element
+// is the inverse of another one; the inverses are added to the connection set by the undirected edges
+vector<int> randomGenerators(int order, int num_generators, const function<int(int)> &inverse, Random &random) {
+    if (num_generators < 0) {
+        throw invalid_argument("Invalid number of generators: " + to_string(num_generators));
+    }
+
+    vector<int> candidates;
+    for (int element = 1; element < order; element++) {
+        if (element <= inverse(element)) {
+            candidates.push_back(element);
+        }
+    }
+
+    if (num_generators > ((int) candidates.size())) {
+        throw invalid_argument("Invalid number of generators: " + to_string(num_generators) +
+            " (the group has " + to_string(candidates.size()) + " non-identity elements up to inversion)");
+    }
+
+    // partial Fisher-Yates shuffle
+    vector<int> generators;
+    for (int i = 0; i < num_generators; i++) {
+        int j = i + ((int) random.uniform(candidates.size() - i));
+        swap(candidates[i], candidates[j]);
+        generators.push_back(candidates[i]);
+    }
+    return generators;
+}
+
+} // namespace
+
+Graph InstanceGenerator::grid2D(int dim_x, int dim_y) {
+    return grid3D(dim_x, dim_y, 1);
+}
+
+Graph InstanceGenerator::grid3D(int dim_x, int dim_y, int dim_z) {
+    validateDimension(dim_x);
+    validateDimension(dim_y);
+    validateDimension(dim_z);
+
+    auto index = [&](int x, int y, int z) { return (z * dim_y + y) * dim_x + x; };
+
+    Graph g(dim_x * dim_y * dim_z);
+    for (int z = 0; z < dim_z; z++) {
+        for (int y = 0; y < dim_y; y++) {
+            for (int x = 0; x < dim_x; x++) {
+                if (x + 1 < dim_x) {
+                    g.insertEdge(Edge(index(x, y, z), index(x + 1, y, z)));
+                }
+                if (y + 1 < dim_y) {
+                    g.insertEdge(Edge(index(x, y, z), index(x, y + 1, z)));
+                }
+                if (z + 1 < dim_z) {
+                    g.insertEdge(Edge(index(x, y, z), index(x, y, z + 1)));
+                }
+            }
+        }
+    }
+    return g;
+}
+
+Graph InstanceGenerator::cycle(int num_vertices) {
+    if (num_vertices < 3) {
+        throw invalid_argument("Invalid number of vertices for a cycle (at least 3): " + to_string(num_vertices));
+    }
+    return circulant(num_vertices, {1});
+}
+
+Graph InstanceGenerator::path(int num_vertices) {
+    validateNumVertices(num_vertices);
+
+    Graph g(num_vertices);
+    for (int v = 0; v + 1 < num_vertices; v++) {
+        g.insertEdge(Edge(v, v + 1));
+    }
+    return g;
+}
+
+Graph InstanceGenerator::randomTree(int num_vertices, Random &random) {
+    validateNumVertices(num_vertices);
+
+    Graph g(num_vertices);
+    if (num_vertices < 3) {
+        if (num_vertices == 2) {
+            g.insertEdge(Edge(0, 1));
+        }
+        return g;
+    }
+
+    vector<int> prufer(num_vertices - 2);
+    vector<int> degree(num_vertices, 1);
+    for (auto &v : prufer) {
+        v = (int) random.uniform(num_vertices);
+        degree[v]++;
+    }
+
+    // linear time decoding: leaf is always the smallest current leaf
+    int ptr = 0;
+    while (degree[ptr] != 1) {
+        ptr++;
+    }
+    int leaf = ptr;
+    for (int v : prufer) {
+        g.insertEdge(Edge(leaf, v));
+        if ((--degree[v] == 1) && (v < ptr)) {
+            leaf = v;
+        } else {
+            ptr++;
+            while (degree[ptr] != 1) {
+                ptr++;
+            }
+            leaf = ptr;
+        }
+    }
+    g.insertEdge(Edge(leaf, num_vertices - 1));
+
+    return g;
+}
+
+Graph InstanceGenerator::gnp(int num_vertices, double p, Random &random) {
+    validateNumVertices(num_vertices);
+    if (!(p >= 0.0 && p <= 1.0)) {
+        throw invalid_argument("Invalid edge probability: " + to_string(p));
+    }
+
+    Graph g(num_vertices);
+    if (p == 0.0) {
+        return g;
+    }
+
+    // skip over the absent edges with geometric jumps (Batagelj and Brandes), so the running time
+    // is proportional to the number of edges generated and not to n^2; a jump is kept as a double until
+    // it is known to land on one of the remaining pairs, since it can be huge when p is small (log1p keeps
+    // log_q from rounding to 0 when p is tiny)
+    double log_q = log1p(-p);
+    int64_t remaining_pairs = (int64_t) num_vertices * (num_vertices - 1) / 2;
+    int v = 1;
+    int64_t w = -1;
+    while (true) {
+        double r = random.real();
+        double skip = (p == 1.0) ? 0.0 : floor(log(1.0 - r) / log_q);
+        if (skip >= (double) remaining_pairs) {
+            break;
+        }
+
+        remaining_pairs -= 1 + (int64_t) skip;
+        w += 1 + (int64_t) skip;
+        while (w >= v) {
+            w -= v;
+            v++;
+        }
+        g.insertEdge(Edge(v, (int) w));
+    }
+    return g;
+}
+
+Graph InstanceGenerator::circulant(int num_vertices, const vector<int> &jumps) {
+    validateNumVertices(num_vertices);
+
+    vector<int> generators;
+    for (int j : jumps) {
+        int generator = ((j % num_vertices) + num_vertices) % num_vertices;
+        if (generator == 0) {
+            throw invalid_argument("Invalid jump: " + to_string(j));
+        }
+        generators.push_back(generator);
+    }
+
+    return cayleyGraph(num_vertices, [=](int a, int b) { return (a + b) % num_vertices; }, generators);
+}
+
+Graph InstanceGenerator::randomCyclicCayley(int n, int num_generators, Random &random) {
+    validateNumVertices(n);
+
+    auto inverse = [=](int a) { return (n - a) % n; };
+    return circulant(n, randomGenerators(n, num_generators, inverse, random));
+}
+
+Graph InstanceGenerator::randomAbelianCayley(int a, int b, int num_generators, Random &random) {
+    validateNumVertices(a);
+    validateNumVertices(b);
+
+    // the element (x, y) of Z_a x Z_b has index x * b + y
+    auto multiply = [=](int g, int h) { return (((g / b) + (h / b)) % a) * b + ((g % b) + (h % b)) % b; };
+    auto inverse = [=](int g) { return ((a - g / b) % a) * b + (b - g % b) % b; };
+
+    return cayleyGraph(a * b, multiply, randomGenerators(a * b, num_generators, inverse, random));
+}
+
+Graph InstanceGenerator::randomDihedralCayley(int m, int num_generators, Random &random) {
+    validateNumVertices(m);
+
+    // the element r^i s^j of the dihedral group of order 2m has index j * m + i,
+    // and (r^i s^j)(r^k s^l) = r^(i + (-1)^j k) s^(j + l)
+    auto multiply = [=](int g, int h) {
+        int i = g % m, j = g / m, k = h % m, l = h / m;
+        int rotation = (j == 0) ? (i + k) % m : ((i - k) % m + m) % m;
+        return ((j + l) % 2) * m + rotation;
+    };
+    auto inverse = [=](int g) { return (g < m) ? (m - g) % m : g; };
+
+    return cayleyGraph(2 * m, multiply, randomGenerators(2 * m, num_generators, inverse, random));
+}
@@ -0,0 +1,34 @@
+#ifndef INSTANCEGENERATOR_H
+
+#define INSTANCEGENERATOR_H
+
+#include "Graph.h"
+#include "Random.h"
+#include <vector>
+
+//generators of the graph classes used in the experiments; the random ones receive the
+//generator so that the same seed always produces the same graph
+class InstanceGenerator {
+public:
+    static Graph grid2D(int dim_x, int dim_y);
+    static Graph grid3D(int dim_x, int dim_y, int dim_z);
+    static Graph cycle(int num_vertices);
+    static Graph path(int num_vertices);
+
+    //uniformly random labelled tree (built from a random Prufer sequence)
+    static Graph randomTree(int num_vertices, Random &random);
+
+    //Erdos-Renyi graph G(n, p)
+    static Graph gnp(int num_vertices, double p, Random &random);
+
+    //Cayley graph of the cyclic group Z_n with connection set {+-j : j in jumps}
+    static Graph circulant(int num_vertices, const std::vector<int> &jumps);
+
+    //Cayley graphs with num_generators random generators (and their inverses) of the groups
+    //Z_n, Z_a x Z_b and the dihedral group of order 2m
+    static Graph randomCyclicCayley(int n, int num_generators, Random &random);
+    static Graph randomAbelianCayley(int a, int b, int num_generators, Random &random);
+    static Graph randomDihedralCayley(int m, int num_generators, Random &random);
+};
+
+#endif /* INSTANCEGENERATOR_H */
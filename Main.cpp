@@ -1,12 +1,16 @@
 #include "Edge.h"
 #include "Graph.h"
 #include "ConfigurationGraph.h"
+#include "Solver.h"
+#include "IncrementalSolver.h"
+#include "StrategyWriter.h"
 #include <exception>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <iostream>
+#include <fstream>
 #include <chrono>
-#include <thread>
-#include <atomic>
 
 using namespace std;
 
@@ -19,51 +23,257 @@ void print_exception(const exception &e, int level = 0) {
     }
 }
 
-void runGraphProcessing(const string& inputFilename, atomic<bool>& graphFinished) {
+void print_usage(const char *program) {
+    cerr << "Usage: " << program << " [options] input_filename\n"
+        << "Options:\n"
+        << "  --threads N      number of threads used to build the configuration graph\n"
+        << "  --time-limit S   maximum running time in seconds (default: 7200)\n"
+        << "  --start-k K      first number of guards that is tried (default: 1)\n"
+        << "  --parallel-elimination\n"
+        << "                   find the safe dominating sets in parallel rounds\n"
+        << "  --symbolic       find the safe dominating sets with BDDs instead of listing them\n"
+        << "  --stats          print the statistics of each number of guards tried\n"
+        << "  --max-memory M   memory budget in bytes, or with a suffix K, M or G (e.g. 8G)\n"
+        << "  --edge-changes F after solving, apply the edge changes of F (lines \"+ u v\" or \"- u v\")\n"
+        << "                   and solve again incrementally after each one (not with --max-memory\n"
+        << "                   or --symbolic)\n"
+        << "  --strategy F     write the response of each safe dominating set to each attack to the\n"
+        << "                   binary file F, which can be queried with tools/query_strategy\n";
+}
+
+size_t parse_memory_size(const string &value) {
+    size_t position;
+    double size = stod(value, &position);
+
+    string suffix = value.substr(position);
+    if ((suffix == "K") || (suffix == "k")) {
+        size *= 1024.0;
+    } else if ((suffix == "M") || (suffix == "m")) {
+        size *= 1024.0 * 1024.0;
+    } else if ((suffix == "G") || (suffix == "g")) {
+        size *= 1024.0 * 1024.0 * 1024.0;
+    } else if (!suffix.empty()) {
+        throw invalid_argument("Invalid memory size: " + value);
+    }
+
+    if (size <= 0) {
+        throw invalid_argument("Invalid memory size: " + value);
+    }
+    return (size_t) size;
+}
+
+void print_statistics(const SolverResult &result) {
+    for (auto &stats : result.iterations) {
+        cout << "Iteration k = " << stats.k
+            << ": dominating sets " << stats.num_dominating_sets
+            << ", transitions " << stats.num_transitions
+            << ", safe sets " << stats.num_safe_dominating_sets
+            << ", filter reject rate " << (100.0 * stats.filter_stats.rejectRate()) << "%"
+            << " (" << stats.filter_stats.num_rejected << " of " << stats.filter_stats.num_candidates << " pairs)"
+            << ", memory " << stats.memory_bytes << " bytes"
+            << ((stats.strategy == SolverStrategy::LowMemory) ? " (low memory strategy)" : "")
+            << ((stats.strategy == SolverStrategy::Symbolic) ? " (symbolic strategy)" : "")
+            << ", time " << stats.elapsed.count() << " ms\n";
+
+        const SizeEstimate &estimate = stats.size_estimate;
+        if (estimate.num_samples > 0) {
+            cout << "  estimated dominating sets " << estimate.num_dominating_sets.value
+                << " [" << estimate.num_dominating_sets.lower << ", " << estimate.num_dominating_sets.upper << "]"
+                << ", estimated transitions " << estimate.num_transitions.value
+                << " [" << estimate.num_transitions.lower << ", " << estimate.num_transitions.upper << "]\n";
+        }
+    }
+}
+
+//print the result of a solve and return true if it was solved
+bool print_result(Graph &g, const SolverResult &result, bool print_stats) {
+    if (print_stats) {
+        print_statistics(result);
+    }
+
+    if (result.status == SolverStatus::TimeLimitExceeded) {
+        cout << "Time limit exceeded: " << result.elapsed.count() << " ms" << endl;
+        return false;
+    }
+
+    if (result.status == SolverStatus::MemoryLimitExceeded) {
+        cout << result.report;
+        cout << "Memory limit exceeded: " << result.elapsed.count() << " ms" << endl;
+        return false;
+    }
+
+    if (!result.dominating_sets.empty()) {
+        ConfigurationGraph configuration_graph(result.dominating_sets.size(), g.numVertices(), result.dominating_sets);
+        configuration_graph.printSafeDominatingSets(result.dominating_sets, result.is_safe);
+    } else if (!result.safe_dominating_sets.empty()) {
+        // the dominating sets were not listed, so the safe ones are printed without their index among them
+        cout << "\n-- Safe Dominating Sets of size " << result.minimum_k << ":\n";
+        for (auto &set : result.safe_dominating_sets) {
+            cout << "Set:";
+            for (int vertex : set) {
+                cout << " " << (vertex + 1);
+            }
+            cout << "\n";
+        }
+    } else {
+        cout << result.num_safe_dominating_sets << " safe dominating sets (not listed: they do not fit in the memory budget)\n";
+    }
+    cout << "\n-- Minimum guard set size: " << result.minimum_k << endl;
+    cout << "Running time: " << result.elapsed.count() << " ms" << endl;
+    return true;
+}
+
+void write_strategy(Graph &g, const SolverResult &result, const string &strategy_filename, int num_threads) {
+    auto start = chrono::steady_clock::now();
+    size_t size = StrategyWriter::write(g, result.safe_dominating_sets, strategy_filename, num_threads);
+    auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+    cout << "Strategy table: " << strategy_filename << " (" << size << " bytes, " << duration.count() << " ms)" << endl;
+}
+
+//solve the graph and then apply the edge changes of a file, one per line as "+ u v" (insert) or "- u v" (remove);
+//the strategy table, if any, is written for the graph after the last change
+void runEdgeChanges(Graph &g, const SolverOptions &options, const string &changes_filename, bool print_stats,
+    const string &strategy_filename) {
+    ifstream file(changes_filename);
+    if (!file.is_open()) {
+        throw runtime_error("Could not open the file " + changes_filename);
+    }
+
+    IncrementalSolver solver(g, options);
+    SolverResult result = solver.solve();
+    if (!print_result(g, result, print_stats)) {
+        return;
+    }
+
+    char change;
+    int u, v;
+    while (file >> change >> u >> v) {
+        if ((change != '+') && (change != '-')) {
+            throw invalid_argument("Invalid edge change: " + string(1, change) + " " + to_string(u) + " " + to_string(v));
+        }
+
+        // vertices are numbered from 1 to n in the file format
+        Edge edge(u - 1, v - 1);
+        result = (change == '+') ? solver.insertEdge(edge) : solver.removeEdge(edge);
+
+        cout << "\nEdge change: " << change << " " << u << " " << v << endl;
+        if (print_stats) {
+            print_statistics(result);
+        }
+        if (result.status == SolverStatus::TimeLimitExceeded) {
+            cout << "Time limit exceeded: " << result.elapsed.count() << " ms" << endl;
+            continue;
+        }
+        cout << "-- Minimum guard set size: " << result.minimum_k << endl;
+        cout << "Running time: " << result.elapsed.count() << " ms" << endl;
+    }
+
+    if (strategy_filename.empty()) {
+        return;
+    }
+    if (result.status != SolverStatus::Solved) {
+        cout << "Strategy table not written: the last edge change was not solved" << endl;
+        return;
+    }
+    write_strategy(g, result, strategy_filename, options.num_threads);
+}
+
+void runGraphProcessing(const string& inputFilename, const SolverOptions &options, bool print_stats,
+    const string &changes_filename, const string &strategy_filename) {
     string instance = inputFilename.substr(inputFilename.find_last_of("/\\") + 1);
     instance = instance.substr(0, instance.find_last_of("."));
 
     cout << "Instance: " << instance << endl;
-    try {
-        Graph g(inputFilename);
-        g.findMinimumGuardSet();
-        graphFinished = true; //If the graph finish the execution
-    } catch (const std::exception& e) {
-        print_exception(e);
+
+    Graph g(inputFilename);
+    if (!changes_filename.empty()) {
+        runEdgeChanges(g, options, changes_filename, print_stats, strategy_filename);
+        return;
+    }
+
+    Solver solver(g, options);
+    SolverResult result = solver.solve();
+    if (!print_result(g, result, print_stats) || strategy_filename.empty()) {
+        return;
     }
+    write_strategy(g, result, strategy_filename, options.num_threads);
 }
 
 int main(int argc, char* argv[]) {
+    SolverOptions options;
+    options.time_limit = chrono::seconds(7200);
 
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " input_filename" << std::endl;
-        return 1;
-    }
+    string input_filename;
+    string changes_filename;
+    string strategy_filename;
+    bool print_stats = false;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--parallel-elimination") {
+                options.parallel_elimination = true;
+                continue;
+            }
 
-    atomic<bool> graphFinished(false);
+            if (arg == "--symbolic") {
+                options.symbolic = true;
+                continue;
+            }
 
-    const int max_time_in_seconds = 7200;
+            if (arg == "--stats") {
+                print_stats = true;
+                continue;
+            }
 
-    std::thread processingThread(runGraphProcessing, argv[1], ref(graphFinished));
+            if ((arg.substr(0, 2) == "--") && (i + 1 >= argc)) {
+                throw invalid_argument("Missing value for option " + arg);
+            }
 
-    auto startTime = chrono::steady_clock::now();
-    while (true) {
-        auto currentTime = chrono::steady_clock::now();
-        auto elapsedMilliseconds = chrono::duration_cast<chrono::milliseconds>(currentTime - startTime);
+            if (arg == "--threads") {
+                options.num_threads = stoi(argv[++i]);
+            } else if (arg == "--time-limit") {
+                options.time_limit = chrono::seconds(stoll(argv[++i]));
+            } else if (arg == "--max-memory") {
+                options.max_memory_bytes = parse_memory_size(argv[++i]);
+            } else if (arg == "--strategy") {
+                strategy_filename = argv[++i];
+            } else if (arg == "--edge-changes") {
+                changes_filename = argv[++i];
+            } else if (arg == "--start-k") {
+                options.starting_k = stoi(argv[++i]);
+            } else if (input_filename.empty() && (arg.substr(0, 2) != "--")) {
+                input_filename = arg;
+            } else {
+                throw invalid_argument("Invalid argument: " + arg);
+            }
+        }
 
-        if (graphFinished) {
-            cout << "Running time: " << elapsedMilliseconds.count() << " ms" << endl;
-            break;
+        // the estimates are only needed to plan around the budget and to be printed with the statistics
+        if ((options.max_memory_bytes > 0) || print_stats) {
+            options.estimation_samples = 2000;
         }
 
-        if (elapsedMilliseconds.count() > max_time_in_seconds * 1000) {
-            cout << "Time limit exceeded: " <<  elapsedMilliseconds.count() << " ms" << endl;
-            return 0;
+        // the incremental solver keeps the explicit configuration graphs, with no memory budget
+        if (!changes_filename.empty() && ((options.max_memory_bytes > 0) || options.symbolic)) {
+            throw invalid_argument("--max-memory and --symbolic can not be used with --edge-changes");
         }
+    } catch (const std::exception& e) {
+        print_exception(e);
+        print_usage(argv[0]);
+        return 1;
     }
 
-    //Wait until the thread process ends
-    processingThread.join();
+    if (input_filename.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        runGraphProcessing(input_filename, options, print_stats, changes_filename, strategy_filename);
+    } catch (const std::exception& e) {
+        print_exception(e);
+    }
 
     return 0;
-}
\ No newline at end of file
+}
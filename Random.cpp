@@ -0,0 +1,52 @@
+#include "Random.h"
+#include <exception>
+#include <stdexcept>
+#include <cstdint>
+
+using namespace std;
+
+Random::Random(uint64_t seed) {
+    // the state is filled with splitmix64, as recommended by the authors of xoshiro
+    for (int i = 0; i < 4; i++) {
+        seed += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state_[i] = z ^ (z >> 31);
+    }
+}
+
+uint64_t Random::next() {
+    auto rotl = [](uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+
+    uint64_t result = rotl(state_[1] * 5, 7) * 9;
+    uint64_t t = state_[1] << 17;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+
+    return result;
+}
+
+uint64_t Random::uniform(uint64_t bound) {
+    if (bound == 0) {
+        throw invalid_argument("Invalid bound: 0");
+    }
+
+    // reject the values of the last incomplete block to avoid modulo bias
+    uint64_t limit = UINT64_MAX - (UINT64_MAX % bound);
+    uint64_t x;
+    do {
+        x = next();
+    } while (x >= limit);
+
+    return x % bound;
+}
+
+double Random::real() {
+    return (next() >> 11) * 0x1.0p-53;
+}
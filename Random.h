@@ -0,0 +1,25 @@
+#ifndef RANDOM_H
+
+#define RANDOM_H
+
+#include <cstdint>
+
+//pseudo-random number generator (xoshiro256** seeded with splitmix64) that produces the same
+//sequence on every platform, so an instance is fully determined by its parameters and its seed
+class Random {
+public:
+    Random(std::uint64_t seed);
+
+    std::uint64_t next();
+
+    //uniform integer in [0, bound)
+    std::uint64_t uniform(std::uint64_t bound);
+
+    //uniform real number in [0, 1)
+    double real();
+
+private:
+    std::uint64_t state_[4];
+};
+
+#endif /* RANDOM_H */
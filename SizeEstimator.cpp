@@ -0,0 +1,138 @@
+#include "SizeEstimator.h"
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <cmath>
+
+using namespace std;
+
+SizeEstimator::SizeEstimator(Graph &graph, size_t num_samples, uint64_t seed)
+    : graph_(graph), num_samples_(num_samples), random_(seed) {
+    if (num_samples == 0) {
+        throw invalid_argument("Invalid number of samples: 0");
+    }
+}
+
+SizeEstimate SizeEstimator::estimate(int k) {
+    if ((k < 1) || (k > graph_.numVertices())) {
+        throw invalid_argument("Invalid dominating set size: " + to_string(k));
+    }
+
+    SizeEstimate size_estimate;
+    vector<vector<int>> dominating_samples;
+
+    // there is no point in taking more samples than the number of k-subsets
+    double num_subsets = binomial(graph_.numVertices(), k);
+    size_t num_samples = (size_t) min((double) num_samples_, num_subsets);
+
+    for (size_t s = 0; s < num_samples; s++) {
+        vector<int> subset = randomSubset(k);
+        if (graph_.isDominatingSet(subset)) {
+            dominating_samples.push_back(subset);
+        }
+    }
+
+    size_estimate.num_samples = num_samples;
+    size_estimate.num_dominating_samples = dominating_samples.size();
+    size_estimate.num_dominating_sets = proportion(dominating_samples.size(), num_samples, num_subsets);
+
+    // the dominating sets are never more than the k-subsets
+    size_estimate.num_dominating_sets.upper = min(size_estimate.num_dominating_sets.upper, num_subsets);
+
+    estimateTransitions(dominating_samples, size_estimate);
+
+    // the sampled dominating sets are a sample of the dominating sets, so the proportion of transitions
+    // among their pairs is scaled to the estimated number of pairs
+    Estimate &d = size_estimate.num_dominating_sets;
+    Estimate &t = size_estimate.num_transitions;
+    double num_sampled = dominating_samples.size();
+    double sampled_pairs = num_sampled * (num_sampled - 1) / 2;
+    double q_lower = (sampled_pairs > 0) ? t.lower / sampled_pairs : 0.0;
+    double q_value = (sampled_pairs > 0) ? t.value / sampled_pairs : 0.0;
+    double q_upper = (sampled_pairs > 0) ? t.upper / sampled_pairs : 1.0;
+    t.lower = q_lower * d.lower * max(d.lower - 1, 0.0) / 2;
+    t.value = q_value * d.value * max(d.value - 1, 0.0) / 2;
+    t.upper = q_upper * d.upper * max(d.upper - 1, 0.0) / 2;
+
+    return size_estimate;
+}
+
+void SizeEstimator::estimateTransitions(const vector<vector<int>> &dominating_sets, SizeEstimate &size_estimate) {
+    size_t num_sets = dominating_sets.size();
+    double num_pairs = ((double) num_sets) * (num_sets - 1) / 2;
+
+    size_estimate.num_pair_samples = 0;
+    size_estimate.num_transition_samples = 0;
+
+    if (num_sets < 2) {
+        size_estimate.num_transitions = Estimate();
+        return;
+    }
+
+    size_t num_samples = (size_t) min((double) num_samples_, num_pairs);
+
+    for (size_t s = 0; s < num_samples; s++) {
+        size_t i = random_.uniform(num_sets);
+        size_t j = random_.uniform(num_sets - 1);
+        if (j >= i) {
+            j++; // j is uniform among the sets different from i
+        }
+
+        size_estimate.num_pair_samples++;
+        if (graph_.isGuardTransition(dominating_sets[i], dominating_sets[j], false)) {
+            size_estimate.num_transition_samples++;
+        }
+    }
+
+    size_estimate.num_transitions = proportion(size_estimate.num_transition_samples, size_estimate.num_pair_samples, num_pairs);
+}
+
+double SizeEstimator::binomial(int n, int k) {
+    if ((k < 0) || (k > n)) {
+        return 0.0;
+    }
+
+    double result = 1.0;
+    for (int i = 1; i <= min(k, n - k); i++) {
+        result = result * (n - min(k, n - k) + i) / i;
+    }
+    return result;
+}
+
+Estimate SizeEstimator::proportion(size_t successes, size_t trials, double population) {
+    Estimate estimate;
+    if (trials == 0) {
+        estimate.upper = population;
+        return estimate;
+    }
+
+    const double z = 1.96;
+    double n = trials;
+    double p = successes / n;
+
+    double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+    double margin = (z / (1 + z * z / n)) * sqrt(p * (1 - p) / n + z * z / (4 * n * n));
+
+    estimate.value = p * population;
+    estimate.lower = max(0.0, center - margin) * population;
+    estimate.upper = min(1.0, center + margin) * population;
+    return estimate;
+}
+
+// Floyd's algorithm for a uniformly random k-subset of the vertices
+vector<int> SizeEstimator::randomSubset(int k) {
+    int n = graph_.numVertices();
+    vector<int> subset;
+    vector<bool> chosen(n, false);
+
+    for (int j = n - k; j < n; j++) {
+        int t = (int) random_.uniform(j + 1);
+        int v = chosen[t] ? j : t;
+        chosen[v] = true;
+        subset.push_back(v);
+    }
+
+    sort(subset.begin(), subset.end());
+    return subset;
+}
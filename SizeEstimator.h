@@ -0,0 +1,57 @@
+#ifndef SIZEESTIMATOR_H
+
+#define SIZEESTIMATOR_H
+
+#include "Graph.h"
+#include "Random.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//estimated value with the bounds of a 95% confidence interval
+struct Estimate {
+    double value = 0.0;
+    double lower = 0.0;
+    double upper = 0.0;
+};
+
+struct SizeEstimate {
+    //number of k-subsets sampled and how many of them are dominating sets
+    std::size_t num_samples = 0;
+    std::size_t num_dominating_samples = 0;
+
+    //number of pairs of dominating sets sampled and how many of them are guard transitions
+    std::size_t num_pair_samples = 0;
+    std::size_t num_transition_samples = 0;
+
+    Estimate num_dominating_sets;
+    Estimate num_transitions;
+};
+
+//estimates the number of dominating sets of size k and the number of edges of their configuration graph
+//by testing random k-subsets and random pairs of dominating sets, before they are generated
+class SizeEstimator {
+public:
+    SizeEstimator(Graph &graph, std::size_t num_samples, std::uint64_t seed = 1);
+
+    //estimate from random k-subsets of vertices; the pairs are taken from the sampled dominating sets
+    SizeEstimate estimate(int k);
+
+    //refine the number of transitions with random pairs of the dominating sets already generated
+    void estimateTransitions(const std::vector<std::vector<int>> &dominating_sets, SizeEstimate &size_estimate);
+
+    //number of subsets of size k of a set of size n
+    static double binomial(int n, int k);
+
+    //Wilson score interval of a proportion scaled to a population of the given size
+    static Estimate proportion(std::size_t successes, std::size_t trials, double population);
+
+private:
+    Graph &graph_;
+    std::size_t num_samples_;
+    Random random_;
+
+    std::vector<int> randomSubset(int k);
+};
+
+#endif /* SIZEESTIMATOR_H */
@@ -0,0 +1,354 @@
+#include "Solver.h"
+#include "ConfigurationGraph.h"
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <memory>
+#include <iostream>
+
+using namespace std;
+
+Solver::Solver(Graph &graph, const SolverOptions &options)
+    : graph_(graph), options_(options), deadline_(options.time_limit) {
+    validateOptions(graph, options);
+}
+
+void Solver::validateOptions(Graph &graph, const SolverOptions &options) {
+    if (options.num_threads < 0) {
+        throw invalid_argument("Invalid number of threads: " + to_string(options.num_threads));
+    }
+
+    if (options.time_limit.count() < 0) {
+        throw invalid_argument("Invalid time limit: " + to_string(options.time_limit.count()) + " ms");
+    }
+
+    if ((options.starting_k < 1) || (options.starting_k > graph.numVertices())) {
+        throw invalid_argument("Invalid starting number of guards: " + to_string(options.starting_k));
+    }
+}
+
+void Solver::setProgressCallback(ProgressCallback callback) {
+    progress_callback_ = callback;
+}
+
+void Solver::setSafeConfigurationCallback(SafeConfigurationCallback callback) {
+    safe_configuration_callback_ = callback;
+}
+
+SolverResult Solver::solve() {
+    SolverResult result;
+    deadline_.start();
+
+    int n = graph_.numVertices();
+    int max_k = n; // the maximum size of a dominating set is the number of vertices in the graph
+    size_t budget = options_.max_memory_bytes;
+
+    SizeEstimator size_estimator(graph_, max(options_.estimation_samples, (size_t) 1));
+
+    // the BDD nodes are shared by all the iterations of the symbolic engine
+    unique_ptr<SymbolicEngine> symbolic_engine;
+    if (options_.symbolic) {
+        // a budget smaller than a node still limits the nodes (0 would mean no limit)
+        size_t max_nodes = (budget > 0) ? max(budget / BDDManager::bytesPerNode(), (size_t) 1) : 0;
+        symbolic_engine.reset(new SymbolicEngine(graph_, max_nodes));
+    }
+
+    // iterating over all possible sizes of dominating sets, starting at the size given in the options
+    for (int k = options_.starting_k; k <= max_k; k++) {
+        if (options_.symbolic) {
+            if (solveSymbolic(k, *symbolic_engine, result)) {
+                break;
+            }
+            continue;
+        }
+
+        chrono::milliseconds iteration_start = deadline_.elapsed();
+        SolverIterationStats stats;
+        stats.k = k;
+
+        // estimate the sizes of the iteration and stop if even the dominating sets can not fit in the budget
+        if (options_.estimation_samples > 0) {
+            reportProgress(k, SolverStage::EstimatingSizes, 0, 0);
+            stats.size_estimate = size_estimator.estimate(k);
+
+            if ((budget > 0) && (lowMemoryUsage(n, k, stats.size_estimate.num_dominating_sets.lower) > budget)) {
+                result.report = memoryReport(stats, "the dominating sets are estimated to need more than the budget");
+                stats.elapsed = deadline_.elapsed() - iteration_start;
+                result.iterations.push_back(stats);
+                result.status = SolverStatus::MemoryLimitExceeded;
+                break;
+            }
+        }
+
+        // the generation stops as soon as the dominating sets do not fit in the budget
+        size_t max_sets = SIZE_MAX;
+        if (budget > 0) {
+            max_sets = (size_t) (budget / lowMemoryUsage(n, k, 1));
+        }
+
+        reportProgress(k, SolverStage::GeneratingDominatingSets, 0, 0);
+        vector<vector<int>> dominating_sets = graph_.generateDominatingSets(k, max_sets, [this]() { return deadline_.exceeded(); });
+        stats.num_dominating_sets = dominating_sets.size();
+
+        if (deadline_.exceeded()) {
+            result.status = SolverStatus::TimeLimitExceeded;
+            break;
+        }
+
+        if (dominating_sets.size() > max_sets) {
+            result.report = memoryReport(stats, "there are more than " + to_string(max_sets) +
+                " dominating sets, which do not fit in the budget");
+            stats.elapsed = deadline_.elapsed() - iteration_start;
+            result.iterations.push_back(stats);
+            result.status = SolverStatus::MemoryLimitExceeded;
+            break;
+        }
+
+        // with the dominating sets known, choose if the configuration graph is stored
+        if (options_.estimation_samples > 0) {
+            size_estimator.estimateTransitions(dominating_sets, stats.size_estimate);
+        }
+
+        if ((budget > 0) && (options_.estimation_samples > 0) &&
+            (explicitMemoryUsage(n, k, dominating_sets.size(), stats.size_estimate.num_transitions.upper) > budget)) {
+            if (!options_.allow_low_memory_strategy) {
+                result.report = memoryReport(stats, "the configuration graph is estimated to need more than the budget");
+                stats.elapsed = deadline_.elapsed() - iteration_start;
+                result.iterations.push_back(stats);
+                result.status = SolverStatus::MemoryLimitExceeded;
+                break;
+            }
+            stats.strategy = SolverStrategy::LowMemory;
+        }
+
+        vector<bool> is_safe;
+        if (stats.strategy == SolverStrategy::Explicit) {
+            // the estimate is only an upper bound with high probability, so the construction also stops as soon as
+            // the transitions found do not fit in the budget
+            size_t max_edges = SIZE_MAX;
+            if (budget > 0) {
+                double base_usage = explicitMemoryUsage(n, k, dominating_sets.size(), 0);
+                double edge_usage = explicitMemoryUsage(n, k, dominating_sets.size(), 1) - base_usage;
+                max_edges = (base_usage < budget) ? (size_t) ((budget - base_usage) / edge_usage) : 0;
+            }
+
+            //generate the configuration graph of the dominating sets of size k
+            reportProgress(k, SolverStage::GeneratingConfigurationGraph, stats.num_dominating_sets, 0);
+            ConfigurationGraph configuration_graph = graph_.generateConfigurationGraph(k, dominating_sets,
+                options_.num_threads, [this]() { return deadline_.exceeded(); }, &stats.filter_stats, max_edges);
+            stats.num_transitions = configuration_graph.numEdges();
+
+            // the dominating sets are kept both by the solver and by the configuration graph
+            stats.memory_bytes = configuration_graph.memoryUsage() +
+                dominating_sets.size() * (sizeof(vector<int>) + k * sizeof(int));
+
+            if (deadline_.exceeded()) {
+                result.status = SolverStatus::TimeLimitExceeded;
+                break;
+            }
+
+            if ((budget > 0) && (((size_t) stats.num_transitions > max_edges) || (stats.memory_bytes > budget))) {
+                if (!options_.allow_low_memory_strategy) {
+                    result.report = memoryReport(stats, "the configuration graph has more than " + to_string(max_edges) +
+                        " transitions, which do not fit in the budget");
+                    stats.elapsed = deadline_.elapsed() - iteration_start;
+                    result.iterations.push_back(stats);
+                    result.status = SolverStatus::MemoryLimitExceeded;
+                    break;
+                }
+
+                // the incomplete configuration graph is discarded
+                stats.strategy = SolverStrategy::LowMemory;
+                stats.num_transitions = 0;
+            } else {
+                // generate the safe dominating sets of the configuration graph
+                reportProgress(k, SolverStage::FindingSafeDominatingSets, stats.num_dominating_sets, stats.num_transitions);
+                is_safe = options_.parallel_elimination ?
+                    configuration_graph.findSafeDominatingSetsParallel(options_.num_threads, [this]() { return deadline_.exceeded(); }) :
+                    configuration_graph.findSafeDominatingSets([this]() { return deadline_.exceeded(); });
+
+                if (deadline_.exceeded()) {
+                    result.status = SolverStatus::TimeLimitExceeded;
+                    break;
+                }
+            }
+        }
+
+        if (stats.strategy == SolverStrategy::LowMemory) {
+            reportProgress(k, SolverStage::FindingSafeDominatingSets, stats.num_dominating_sets, 0);
+            is_safe = graph_.findSafeDominatingSetsImplicit(dominating_sets, options_.num_threads,
+                [this]() { return deadline_.exceeded(); }, &stats.filter_stats);
+            stats.memory_bytes = (size_t) lowMemoryUsage(n, k, dominating_sets.size());
+
+            if (deadline_.exceeded()) {
+                result.status = SolverStatus::TimeLimitExceeded;
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < dominating_sets.size(); i++) {
+            if (is_safe[i]) {
+                stats.num_safe_dominating_sets++;
+                if (safe_configuration_callback_) {
+                    safe_configuration_callback_(k, dominating_sets[i]);
+                }
+            }
+        }
+
+        stats.elapsed = deadline_.elapsed() - iteration_start;
+        result.iterations.push_back(stats);
+
+        // if there is a safe dominating set, then k is the minimum number of guards
+        if (stats.num_safe_dominating_sets > 0) {
+            result.status = SolverStatus::Solved;
+            result.minimum_k = k;
+            for (size_t i = 0; i < dominating_sets.size(); i++) {
+                if (is_safe[i]) {
+                    result.safe_dominating_sets.push_back(dominating_sets[i]);
+                }
+            }
+            result.dominating_sets = move(dominating_sets);
+            result.is_safe = move(is_safe);
+            result.num_safe_dominating_sets = stats.num_safe_dominating_sets;
+            reportProgress(k, SolverStage::Finished, stats.num_dominating_sets, stats.num_transitions);
+            break;
+        }
+    }
+
+    result.elapsed = deadline_.elapsed();
+    return result;
+}
+
+// the counts of the BDDs are doubles, which can be larger than any size_t
+static size_t clampedCount(double count) {
+    return (count < (double) SIZE_MAX) ? (size_t) count : SIZE_MAX;
+}
+
+bool Solver::solveSymbolic(int k, SymbolicEngine &engine, SolverResult &result) {
+    chrono::milliseconds iteration_start = deadline_.elapsed();
+    SolverIterationStats stats;
+    stats.k = k;
+    stats.strategy = SolverStrategy::Symbolic;
+
+    try {
+        reportProgress(k, SolverStage::GeneratingDominatingSets, 0, 0);
+        BDD dominating_sets = engine.dominatingSets(k);
+        stats.num_dominating_sets = clampedCount(engine.count(dominating_sets));
+
+        reportProgress(k, SolverStage::FindingSafeDominatingSets, stats.num_dominating_sets, 0);
+        BDD safe = engine.safeDominatingSets(dominating_sets, [this]() { return deadline_.exceeded(); });
+        stats.memory_bytes = engine.manager().memoryUsage();
+
+        if (deadline_.exceeded()) {
+            result.status = SolverStatus::TimeLimitExceeded;
+            return true;
+        }
+
+        stats.num_safe_dominating_sets = clampedCount(engine.count(safe));
+        stats.elapsed = deadline_.elapsed() - iteration_start;
+        result.iterations.push_back(stats);
+
+        if (stats.num_safe_dominating_sets == 0) {
+            return false;
+        }
+
+        // k is the minimum number of guards; only the safe dominating sets are listed, and only when they
+        // fit in the memory budget, while the callback receives all of them
+        double list_size = lowMemoryUsage(graph_.numVertices(), k, stats.num_safe_dominating_sets);
+        bool list = (options_.max_memory_bytes == 0) || (stats.memory_bytes + list_size <= options_.max_memory_bytes);
+        if (list || safe_configuration_callback_) {
+            engine.enumerate(safe, [&](const vector<int> &set) {
+                if (safe_configuration_callback_) {
+                    safe_configuration_callback_(k, set);
+                }
+                if (list) {
+                    result.safe_dominating_sets.push_back(set);
+                }
+            });
+        }
+    } catch (const length_error &e) {
+        result.safe_dominating_sets.clear();
+        stats.memory_bytes = engine.manager().memoryUsage();
+        stats.elapsed = deadline_.elapsed() - iteration_start;
+        result.report = memoryReport(stats, string("the BDDs need more nodes than the budget (") + e.what() + ")");
+        result.iterations.push_back(stats);
+        result.status = SolverStatus::MemoryLimitExceeded;
+        return true;
+    }
+
+    result.status = SolverStatus::Solved;
+    result.minimum_k = k;
+    result.num_safe_dominating_sets = stats.num_safe_dominating_sets;
+    reportProgress(k, SolverStage::Finished, stats.num_dominating_sets, 0);
+    return true;
+}
+
+double Solver::lowMemoryUsage(int num_vertices, int k, double num_sets) {
+    // the dominating sets, their bitmasks in the TransitionFilter and two bytes per set to mark the safe ones
+    double dominating_sets_size = num_sets * (sizeof(vector<int>) + k * sizeof(int));
+    double bitmasks_size = num_sets * ((num_vertices + 63) / 64) * sizeof(uint64_t);
+    return dominating_sets_size + bitmasks_size + 2 * num_sets;
+}
+
+double Solver::explicitMemoryUsage(int num_vertices, int k, double num_sets, double num_transitions) {
+    // the edges are buffered by the threads before they are inserted in the configuration graph
+    return lowMemoryUsage(num_vertices, k, num_sets) + ConfigurationGraph::memoryUsage(num_sets, k, num_transitions) +
+        num_transitions * sizeof(pair<int, int>);
+}
+
+SolverDeadline::SolverDeadline(chrono::milliseconds time_limit) : time_limit_(time_limit) {
+    start();
+}
+
+void SolverDeadline::start() {
+    start_time_ = chrono::steady_clock::now();
+}
+
+chrono::milliseconds SolverDeadline::elapsed() const {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_time_);
+}
+
+bool SolverDeadline::exceeded() const {
+    return (time_limit_.count() > 0) && (elapsed() > time_limit_);
+}
+
+string Solver::memoryReport(const SolverIterationStats &stats, const string &reason) {
+    const SizeEstimate &estimate = stats.size_estimate;
+    ostringstream report;
+
+    report << "Memory budget of " << options_.max_memory_bytes << " bytes exceeded for k = " << stats.k << ": " << reason << "\n";
+    if (estimate.num_samples > 0) {
+        report << "  dominating sets: estimated " << estimate.num_dominating_sets.value
+            << " (95% interval " << estimate.num_dominating_sets.lower << " to " << estimate.num_dominating_sets.upper << ")"
+            << ", " << estimate.num_dominating_samples << " of " << estimate.num_samples << " sampled subsets are dominating\n";
+        report << "  transitions: estimated " << estimate.num_transitions.value
+            << " (95% interval " << estimate.num_transitions.lower << " to " << estimate.num_transitions.upper << ")"
+            << ", " << estimate.num_transition_samples << " of " << estimate.num_pair_samples << " sampled pairs are transitions\n";
+        report << "  memory: at least " << lowMemoryUsage(graph_.numVertices(), stats.k, estimate.num_dominating_sets.lower)
+            << " bytes for the dominating sets, about "
+            << explicitMemoryUsage(graph_.numVertices(), stats.k, estimate.num_dominating_sets.value, estimate.num_transitions.value)
+            << " bytes with the configuration graph\n";
+    }
+
+    return report.str();
+}
+
+void Solver::reportProgress(int k, SolverStage stage, size_t num_dominating_sets, size_t num_transitions) {
+    if (progress_callback_) {
+        progress_callback_({k, stage, num_dominating_sets, num_transitions, deadline_.elapsed()});
+    }
+}
+
+// a member of Graph, defined with the solver so that Graph does not depend on it
+void Graph::findMinimumGuardSet(){
+    Solver solver(*this);
+    SolverResult result = solver.solve();
+
+    ConfigurationGraph configuration_graph(result.dominating_sets.size(), numVertices(), result.dominating_sets);
+    configuration_graph.printSafeDominatingSets(result.dominating_sets, result.is_safe);
+    cout << "\n-- Minimum guard set size: " << result.minimum_k << endl;
+}
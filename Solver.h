@@ -0,0 +1,171 @@
+#ifndef SOLVER_H
+
+#define SOLVER_H
+
+#include "Graph.h"
+#include "TransitionFilter.h"
+#include "SizeEstimator.h"
+#include "SymbolicEngine.h"
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+//options that control a run of the solver; the default values reproduce the behaviour of Graph::findMinimumGuardSet
+struct SolverOptions {
+    //number of threads used to build the configuration graph (0 uses the OpenMP default)
+    int num_threads = 0;
+
+    //maximum running time of a call to Solver::solve (0 means no limit)
+    std::chrono::milliseconds time_limit = std::chrono::milliseconds(0);
+
+    //first number of guards that is tried
+    int starting_k = 1;
+
+    //maximum number of bytes used by the dominating sets and the configuration graph (0 means no limit);
+    //when the configuration graph is not expected to fit, or its construction finds more transitions than
+    //fit, the safe dominating sets are found with the low memory strategy (if allowed), and when the
+    //dominating sets do not fit, the run stops
+    std::size_t max_memory_bytes = 0;
+    bool allow_low_memory_strategy = true;
+
+    //number of random k-subsets and of random pairs of dominating sets used to estimate the sizes of
+    //each iteration before it starts (e.g. 2000); 0 disables the estimation, and the memory budget is then
+    //only enforced by the limits on the dominating sets and transitions that are found
+    std::size_t estimation_samples = 0;
+
+    //find the safe dominating sets with the parallel rounds of ConfigurationGraph::findSafeDominatingSetsParallel
+    bool parallel_elimination = false;
+
+    //find the safe dominating sets with the BDDs of SymbolicEngine, without listing the dominating sets of each k;
+    //the memory budget limits the number of BDD nodes and only the safe dominating sets of the minimum k are
+    //listed, when they fit in what is left of the budget
+    bool symbolic = false;
+};
+
+enum class SolverStatus {
+    Solved,
+    TimeLimitExceeded,
+    MemoryLimitExceeded
+};
+
+//the configuration graph is either stored (Explicit), its edges are computed again when needed (LowMemory)
+//or it is represented by BDDs (Symbolic)
+enum class SolverStrategy {
+    Explicit,
+    LowMemory,
+    Symbolic
+};
+
+enum class SolverStage {
+    EstimatingSizes,
+    GeneratingDominatingSets,
+    GeneratingConfigurationGraph,
+    FindingSafeDominatingSets,
+    Finished
+};
+
+//snapshot of the solver state passed to the progress callback
+struct SolverProgress {
+    int k;
+    SolverStage stage;
+    std::size_t num_dominating_sets;
+    std::size_t num_transitions;
+    std::chrono::milliseconds elapsed;
+};
+
+//statistics of the iteration for one value of k
+struct SolverIterationStats {
+    int k = 0;
+    SolverStrategy strategy = SolverStrategy::Explicit;
+    std::size_t num_dominating_sets = 0;
+    std::size_t num_transitions = 0; // not computed by the low memory and symbolic strategies
+    std::size_t num_safe_dominating_sets = 0;
+    std::size_t memory_bytes = 0;
+    std::chrono::milliseconds elapsed = std::chrono::milliseconds(0);
+
+    //pairs of dominating sets tested by the TransitionFilter and pairs rejected by it
+    TransitionFilterStats filter_stats;
+
+    //estimated sizes; the number of transitions is refined with the dominating sets once they are generated
+    SizeEstimate size_estimate;
+};
+
+struct SolverResult {
+    SolverStatus status = SolverStatus::Solved;
+
+    //minimum number of guards, or -1 if the run stopped before finding it
+    int minimum_k = -1;
+
+    //dominating sets of size minimum_k and, for each one of them, if it is safe; the symbolic strategy does
+    //not list the dominating sets, so both are empty with it
+    std::vector<std::vector<int>> dominating_sets;
+    std::vector<bool> is_safe;
+
+    //safe dominating sets of size minimum_k in lexicographic order, listed by every strategy (by the symbolic
+    //one only when they fit in the memory budget)
+    std::vector<std::vector<int>> safe_dominating_sets;
+    std::size_t num_safe_dominating_sets = 0;
+
+    std::vector<SolverIterationStats> iterations;
+    std::chrono::milliseconds elapsed = std::chrono::milliseconds(0);
+
+    //explanation of why the run stopped when the status is MemoryLimitExceeded
+    std::string report;
+};
+
+//start time and time limit of a call to solve, shared by Solver and IncrementalSolver
+class SolverDeadline {
+public:
+    SolverDeadline(std::chrono::milliseconds time_limit);
+
+    void start();
+    std::chrono::milliseconds elapsed() const;
+    bool exceeded() const;
+
+private:
+    std::chrono::milliseconds time_limit_;
+    std::chrono::steady_clock::time_point start_time_;
+};
+
+//solver for the m-eternal dominating set problem that can be embedded in other programs:
+//nothing is written to the standard output and the results are returned in a SolverResult
+class Solver {
+public:
+    typedef std::function<void(const SolverProgress &)> ProgressCallback;
+    typedef std::function<void(int, const std::vector<int> &)> SafeConfigurationCallback;
+
+    Solver(Graph &graph, const SolverOptions &options = SolverOptions());
+
+    //called every time the solver starts a new stage of an iteration
+    void setProgressCallback(ProgressCallback callback);
+
+    //called for each safe dominating set of size k (the vertices are numbered from 0 to n - 1)
+    void setSafeConfigurationCallback(SafeConfigurationCallback callback);
+
+    SolverResult solve();
+
+    //throw invalid_argument if the options can not be used with the graph
+    static void validateOptions(Graph &graph, const SolverOptions &options);
+
+    //approximate number of bytes used by an iteration with num_sets dominating sets of size k
+    static double lowMemoryUsage(int num_vertices, int k, double num_sets);
+    static double explicitMemoryUsage(int num_vertices, int k, double num_sets, double num_transitions);
+
+private:
+    Graph &graph_;
+    SolverOptions options_;
+    ProgressCallback progress_callback_;
+    SafeConfigurationCallback safe_configuration_callback_;
+
+    SolverDeadline deadline_;
+
+    std::string memoryReport(const SolverIterationStats &stats, const std::string &reason);
+
+    //iteration for k with the symbolic engine; returns true when the run stops
+    bool solveSymbolic(int k, SymbolicEngine &engine, SolverResult &result);
+    void reportProgress(int k, SolverStage stage, std::size_t num_dominating_sets, std::size_t num_transitions);
+};
+
+#endif /* SOLVER_H */
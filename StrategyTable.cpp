@@ -0,0 +1,123 @@
+#include "StrategyTable.h"
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+const char StrategyTable::MAGIC[8] = {'E', 'D', 'S', 'T', 'R', 'A', 'T', '\0'};
+const uint32_t StrategyTable::VERSION = 1;
+
+StrategyTable::StrategyTable(const string &filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Could not open the file " + filename);
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw runtime_error("Could not read the size of the file " + filename);
+    }
+    size_ = file_stat.st_size;
+
+    if (size_ < sizeof(StrategyHeader)) {
+        close(fd);
+        throw runtime_error("The file " + filename + " is not a strategy table");
+    }
+
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw runtime_error("Could not map the file " + filename);
+    }
+    data_ = (const unsigned char *) data;
+    header_ = (const StrategyHeader *) data_;
+
+    uint64_t num_entries = (uint64_t) header_->num_configurations * header_->num_vertices;
+    bool valid = (memcmp(header_->magic, MAGIC, sizeof(header_->magic)) == 0) &&
+        (header_->version == VERSION) &&
+        (header_->successors_offset >= sizeof(StrategyHeader) + (uint64_t) header_->num_configurations * header_->k * sizeof(uint16_t)) &&
+        (header_->destinations_offset >= header_->successors_offset + num_entries * sizeof(uint32_t)) &&
+        (size_ >= header_->destinations_offset + num_entries * header_->k * sizeof(uint16_t));
+
+    if (!valid) {
+        munmap((void *) data_, size_);
+        throw runtime_error("The file " + filename + " is not a valid strategy table");
+    }
+}
+
+StrategyTable::~StrategyTable() {
+    munmap((void *) data_, size_);
+}
+
+int StrategyTable::numVertices() {
+    return header_->num_vertices;
+}
+
+int StrategyTable::k() {
+    return header_->k;
+}
+
+int StrategyTable::numConfigurations() {
+    return header_->num_configurations;
+}
+
+const uint16_t *StrategyTable::configuration(int c) {
+    validateQuery(c, 0);
+    return (const uint16_t *) (data_ + sizeof(StrategyHeader)) + (size_t) c * header_->k;
+}
+
+uint32_t StrategyTable::successor(int c, int a) {
+    validateQuery(c, a);
+    return ((const uint32_t *) (data_ + header_->successors_offset))[(size_t) c * header_->num_vertices + a];
+}
+
+const uint16_t *StrategyTable::destinations(int c, int a) {
+    validateQuery(c, a);
+    size_t entry = (size_t) c * header_->num_vertices + a;
+    return (const uint16_t *) (data_ + header_->destinations_offset) + entry * header_->k;
+}
+
+int StrategyTable::findConfiguration(vector<int> vertices) {
+    if ((int) vertices.size() != k()) {
+        return -1;
+    }
+    sort(vertices.begin(), vertices.end());
+
+    // the configurations are in lexicographic order
+    int low = 0;
+    int high = numConfigurations() - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        const uint16_t *middle_vertices = configuration(middle);
+        int comparison = 0;
+        for (int g = 0; (g < k()) && (comparison == 0); g++) {
+            comparison = (middle_vertices[g] < vertices[g]) ? -1 : ((middle_vertices[g] > vertices[g]) ? 1 : 0);
+        }
+
+        if (comparison == 0) {
+            return middle;
+        } else if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return -1;
+}
+
+void StrategyTable::validateQuery(int c, int a) {
+    if ((c < 0) || (c >= numConfigurations())) {
+        throw out_of_range("Invalid configuration index: " + to_string(c));
+    }
+    if ((a < 0) || (a >= numVertices())) {
+        throw out_of_range("Invalid vertex index: " + to_string(a));
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef STRATEGYTABLE_H
+
+#define STRATEGYTABLE_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+//binary table with the defense of every safe configuration against every attack, written once after a
+//solve by StrategyWriter and read through a memory map, so a response is found in constant time without
+//the solver (this class does not depend on the rest of the solver, so the query tool can be built alone)
+//
+//layout (native byte order): a StrategyHeader, then the safe configurations in lexicographic order
+//(k uint16 vertices each), then the successor of each configuration c for each attacked vertex a at
+//index c * n + a (uint32), and then the destination of each guard of c for each a at index
+//(c * n + a) * k + g (uint16). An attack on a guarded vertex is answered with the same configuration
+class StrategyTable {
+public:
+    struct StrategyHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t num_vertices;
+        std::uint32_t k;
+        std::uint32_t num_configurations;
+        std::uint64_t successors_offset;
+        std::uint64_t destinations_offset;
+    };
+
+    static const char MAGIC[8];
+    static const std::uint32_t VERSION;
+
+    //memory map a table written by StrategyWriter::write
+    StrategyTable(const std::string &filename);
+    ~StrategyTable();
+
+    StrategyTable(const StrategyTable &) = delete;
+    StrategyTable &operator=(const StrategyTable &) = delete;
+
+    int numVertices();
+    int k();
+    int numConfigurations();
+
+    //vertices of configuration c (k of them, in increasing order)
+    const std::uint16_t *configuration(int c);
+
+    //configuration that defends configuration c against an attack on vertex a
+    std::uint32_t successor(int c, int a);
+
+    //destination of each guard of configuration c (k of them, in the order of configuration(c))
+    const std::uint16_t *destinations(int c, int a);
+
+    //index of a configuration given by its vertices, or -1 if it is not in the table (binary search)
+    int findConfiguration(std::vector<int> vertices);
+
+private:
+    const unsigned char *data_;
+    std::size_t size_;
+    const StrategyHeader *header_;
+
+    void validateQuery(int c, int a);
+};
+
+#endif /* STRATEGYTABLE_H */
@@ -0,0 +1,130 @@
+#include "StrategyWriter.h"
+#include "StrategyTable.h"
+#include "Threads.h"
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <atomic>
+#include <omp.h>
+
+using namespace std;
+
+size_t StrategyWriter::write(Graph &graph, const vector<vector<int>> &safe_sets, const string &filename, int num_threads) {
+    int n = graph.numVertices();
+    if (safe_sets.empty()) {
+        throw invalid_argument("There are no safe dominating sets to write");
+    }
+    if (n > UINT16_MAX) {
+        throw invalid_argument("Invalid number of vertices for a strategy table: " + to_string(n));
+    }
+
+    int k = safe_sets[0].size();
+    vector<vector<int>> configurations = safe_sets;
+    for (auto &configuration : configurations) {
+        if ((int) configuration.size() != k) {
+            throw invalid_argument("The safe dominating sets do not have the same size");
+        }
+        sort(configuration.begin(), configuration.end());
+    }
+    sort(configurations.begin(), configurations.end());
+
+    int m = configurations.size();
+    vector<vector<int>> containing(n); // containing[v] has the configurations with a guard on v
+    for (int c = 0; c < m; c++) {
+        for (int v : configurations[c]) {
+            containing[v].push_back(c);
+        }
+    }
+
+    vector<uint32_t> successors((size_t) m * n);
+    vector<uint16_t> destinations((size_t) m * n * k);
+
+    num_threads = resolveNumThreads(num_threads);
+    atomic<int> unsafe_configuration(-1);
+
+    // every configuration is safe, so for each attack there is a safe configuration with a guard on the
+    // attacked vertex that the guards can move to
+    #pragma omp parallel num_threads(num_threads)
+    {
+        vector<int> moves;
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int c = 0; c < m; c++) {
+            const vector<int> &configuration = configurations[c];
+
+            for (int a = 0; a < n; a++) {
+                size_t entry = (size_t) c * n + a;
+                int successor = -1;
+
+                if (binary_search(configuration.begin(), configuration.end(), a)) {
+                    successor = c;
+                    moves = configuration;
+                } else {
+                    for (int t : containing[a]) {
+                        if (graph.findGuardMoves(configuration, configurations[t], moves)) {
+                            successor = t;
+                            break;
+                        }
+                    }
+                }
+
+                if (successor < 0) {
+                    unsafe_configuration = c;
+                    break;
+                }
+
+                successors[entry] = successor;
+                for (int g = 0; g < k; g++) {
+                    destinations[entry * k + g] = moves[g];
+                }
+            }
+        }
+    }
+
+    if (unsafe_configuration >= 0) {
+        string vertices;
+        for (int v : configurations[unsafe_configuration]) {
+            vertices += " " + to_string(v + 1);
+        }
+        throw invalid_argument("The dominating set" + vertices + " is not safe");
+    }
+
+    StrategyTable::StrategyHeader header;
+    memcpy(header.magic, StrategyTable::MAGIC, sizeof(header.magic));
+    header.version = StrategyTable::VERSION;
+    header.num_vertices = n;
+    header.k = k;
+    header.num_configurations = m;
+
+    // the successors are aligned to 4 bytes after the uint16 configurations
+    size_t configurations_size = (size_t) m * k * sizeof(uint16_t);
+    header.successors_offset = (sizeof(StrategyTable::StrategyHeader) + configurations_size + 3) / 4 * 4;
+    header.destinations_offset = header.successors_offset + successors.size() * sizeof(uint32_t);
+
+    vector<uint16_t> configuration_vertices;
+    configuration_vertices.reserve((size_t) m * k);
+    for (auto &configuration : configurations) {
+        configuration_vertices.insert(configuration_vertices.end(), configuration.begin(), configuration.end());
+    }
+
+    ofstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        throw runtime_error("Could not open the file " + filename);
+    }
+
+    const char padding[4] = {0, 0, 0, 0};
+    file.write((const char *) &header, sizeof(header));
+    file.write((const char *) configuration_vertices.data(), configurations_size);
+    file.write(padding, header.successors_offset - sizeof(StrategyTable::StrategyHeader) - configurations_size);
+    file.write((const char *) successors.data(), successors.size() * sizeof(uint32_t));
+    file.write((const char *) destinations.data(), destinations.size() * sizeof(uint16_t));
+
+    if (!file) {
+        throw runtime_error("Could not write the file " + filename);
+    }
+
+    return header.destinations_offset + destinations.size() * sizeof(uint16_t);
+}
@@ -0,0 +1,19 @@
+#ifndef STRATEGYWRITER_H
+
+#define STRATEGYWRITER_H
+
+#include "Graph.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+//writer of the StrategyTable files, kept apart from the reader so the query tool does not need the solver
+class StrategyWriter {
+public:
+    //compute the responses of the safe dominating sets of size k of the graph and write the table; the
+    //responses of different configurations are computed by num_threads threads (0 uses the OpenMP default)
+    static std::size_t write(Graph &graph, const std::vector<std::vector<int>> &safe_sets, const std::string &filename,
+        int num_threads = 0);
+};
+
+#endif /* STRATEGYWRITER_H */
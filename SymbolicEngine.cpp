@@ -0,0 +1,125 @@
+#include "SymbolicEngine.h"
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+
+using namespace std;
+
+SymbolicEngine::SymbolicEngine(Graph &graph, size_t max_nodes)
+    : num_vertices_(graph.numVertices()), manager_(2 * graph.numVertices(), max_nodes) {
+    x_vars_.resize(num_vertices_);
+    y_vars_.resize(num_vertices_);
+    closed_neighborhoods_.resize(num_vertices_);
+    last_mover_.assign(num_vertices_, -1);
+
+    for (int v = 0; v < num_vertices_; v++) {
+        x_vars_[v] = 2 * v;
+        y_vars_[v] = 2 * v + 1;
+
+        closed_neighborhoods_[v] = graph.closedNeighborhood(v);
+        for (int u : closed_neighborhoods_[v]) {
+            last_mover_[u] = max(last_mover_[u], v);
+        }
+    }
+
+    // permutation that swaps x_v and y_v
+    x_to_y_.resize(2 * num_vertices_);
+    for (int v = 0; v < num_vertices_; v++) {
+        x_to_y_[x_vars_[v]] = y_vars_[v];
+        x_to_y_[y_vars_[v]] = x_vars_[v];
+    }
+}
+
+BDD SymbolicEngine::dominatingSets(int k) {
+    if ((k < 0) || (k > num_vertices_)) {
+        throw invalid_argument("Invalid dominating set size: " + to_string(k));
+    }
+
+    // exactly k of the x variables are true: count[c] has the assignments of x_v, ..., x_{n-1} with c true variables
+    vector<BDD> count(k + 1, manager_.zero());
+    count[0] = manager_.one();
+    for (int v = num_vertices_ - 1; v >= 0; v--) {
+        BDD x = manager_.var(x_vars_[v]);
+        for (int c = k; c >= 0; c--) {
+            count[c] = manager_.ite(x, (c > 0) ? count[c - 1] : manager_.zero(), count[c]);
+        }
+    }
+
+    // every vertex has a vertex of its closed neighborhood in the set
+    BDD dominating_sets = count[k];
+    for (int v = 0; (v < num_vertices_) && !dominating_sets.isZero(); v++) {
+        BDD dominated = manager_.zero();
+        for (int u : closed_neighborhoods_[v]) {
+            dominated = dominated | manager_.var(x_vars_[u]);
+        }
+        dominating_sets = dominating_sets & dominated;
+    }
+
+    return dominating_sets;
+}
+
+BDD SymbolicEngine::preimage(const BDD &targets) {
+    // reachable(x_0, ..., x_{v-1}, y) holds when the guards on x_0, ..., x_{v-1} can move to distinct
+    // vertices of a set of targets, and y has the targets that were not taken yet
+    BDD reachable = targets;
+
+    for (int v = 0; v < num_vertices_; v++) {
+        // if there is a guard on v, it takes one of the targets of its closed neighborhood: the relational
+        // product with y_u quantifies y_u away from the targets that contain u, and u is then marked as taken
+        BDD moved = manager_.zero();
+        for (int u : closed_neighborhoods_[v]) {
+            BDD y = manager_.var(y_vars_[u]);
+            moved = moved | (manager_.andExists(reachable, y, y) & manager_.nvar(y_vars_[u]));
+        }
+        reachable = manager_.ite(manager_.var(x_vars_[v]), moved, reachable);
+
+        // the targets that no other guard can take must have been taken already
+        for (int u : closed_neighborhoods_[v]) {
+            if (last_mover_[u] == v) {
+                reachable = manager_.restrict(reachable, y_vars_[u], false);
+            }
+        }
+    }
+
+    return reachable;
+}
+
+BDD SymbolicEngine::safeDominatingSets(const BDD &dominating_sets, const function<bool()> &should_stop) {
+    // a set is safe when, for each attacked vertex a, a is in the set or the guards can move
+    // to a safe set that contains a
+    BDD safe = dominating_sets;
+    while (true) {
+        BDD safe_targets = manager_.permute(safe, x_to_y_);
+
+        BDD defended = safe;
+        for (int a = 0; (a < num_vertices_) && !defended.isZero(); a++) {
+            if (should_stop && should_stop()) {
+                return safe;
+            }
+
+            BDD can_move = preimage(safe_targets & manager_.var(y_vars_[a]));
+            defended = defended & (manager_.var(x_vars_[a]) | can_move);
+        }
+
+        if (defended == safe) {
+            break;
+        }
+        safe = defended;
+    }
+
+    return safe;
+}
+
+double SymbolicEngine::count(const BDD &configurations) {
+    return manager_.satCount(configurations, x_vars_);
+}
+
+void SymbolicEngine::enumerate(const BDD &configurations, const function<void(const vector<int> &)> &callback) {
+    // the positions in x_vars_ are the vertices
+    manager_.enumerate(configurations, x_vars_, callback);
+}
+
+BDDManager &SymbolicEngine::manager() {
+    return manager_;
+}
@@ -0,0 +1,60 @@
+#ifndef SYMBOLICENGINE_H
+
+#define SYMBOLICENGINE_H
+
+#include "Graph.h"
+#include "BDD.h"
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+//symbolic version of the configuration graph: sets of configurations are represented by BDDs over one
+//variable x_v (current configuration) and one variable y_v (next configuration) per vertex, and the safe
+//dominating sets are found with preimages of the guard moves, without listing the dominating sets
+class SymbolicEngine {
+public:
+    //max_nodes limits the number of BDD nodes (0 means no limit); when it is exceeded, the
+    //operations throw std::length_error
+    SymbolicEngine(Graph &graph, std::size_t max_nodes = 0);
+
+    //dominating sets of size k, over the x variables
+    BDD dominatingSets(int k);
+
+    //sets x (over the x variables) whose guards can move to a set y of targets (over the y variables),
+    //each guard to a vertex of its closed neighborhood, as in Graph::isGuardTransition
+    //
+    //the guard move relation is never built as a whole: the guards are moved one vertex at a time,
+    //and a y variable is marked as taken when a guard moves to it, so the relational product is
+    //split into one small step per vertex
+    BDD preimage(const BDD &targets);
+
+    //greatest subset of dominating_sets in which every set is safe, computed in rounds as in
+    //ConfigurationGraph::findSafeDominatingSetsParallel; if should_stop returns true, the rounds
+    //stop and the result may still have unsafe sets
+    BDD safeDominatingSets(const BDD &dominating_sets, const std::function<bool()> &should_stop = nullptr);
+
+    //number of sets of a BDD over the x variables
+    double count(const BDD &configurations);
+
+    //call callback for each set of a BDD over the x variables (vertices numbered from 0 to n - 1), in the
+    //order of Graph::generateDominatingSets
+    void enumerate(const BDD &configurations, const std::function<void(const std::vector<int> &)> &callback);
+
+    BDDManager &manager();
+
+private:
+    int num_vertices_;
+
+    //the variables of a vertex are next to each other, x_v = 2v and y_v = 2v + 1
+    std::vector<int> x_vars_;
+    std::vector<int> y_vars_;
+    std::vector<int> x_to_y_;
+    std::vector<std::vector<int>> closed_neighborhoods_;
+
+    //last_mover_[u] is the last vertex whose guard can move to u; after it moves, u can not be taken anymore
+    std::vector<int> last_mover_;
+
+    BDDManager manager_;
+};
+
+#endif /* SYMBOLICENGINE_H */
@@ -0,0 +1,6 @@
+#include "Threads.h"
+#include <omp.h>
+
+int resolveNumThreads(int num_threads) {
+    return (num_threads > 0) ? num_threads : omp_get_max_threads();
+}
@@ -0,0 +1,8 @@
+#ifndef THREADS_H
+
+#define THREADS_H
+
+//number of threads of a parallel region: num_threads if it is positive, or the OpenMP default otherwise
+int resolveNumThreads(int num_threads);
+
+#endif /* THREADS_H */
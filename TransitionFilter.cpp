@@ -0,0 +1,161 @@
+#include "TransitionFilter.h"
+#include "Graph.h"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+double TransitionFilterStats::rejectRate() const {
+    return (num_candidates == 0) ? 0.0 : ((double) num_rejected) / num_candidates;
+}
+
+TransitionFilter::TransitionFilter(Graph &graph, const vector<vector<int>> &configurations) {
+    num_vertices_ = graph.numVertices();
+    num_words_ = (num_vertices_ + 63) / 64;
+    configuration_size_ = configurations.empty() ? 0 : configurations[0].size();
+
+    neighborhood_masks_.assign(((size_t) num_vertices_) * num_words_, 0);
+    for (int v = 0; v < num_vertices_; v++) {
+        for (int u : graph.closedNeighborhood(v)) {
+            neighborhood_masks_[((size_t) v) * num_words_ + u / 64] |= 1ULL << (u % 64);
+        }
+    }
+
+    configuration_masks_.assign(configurations.size() * num_words_, 0);
+    for (size_t i = 0; i < configurations.size(); i++) {
+        for (int v : configurations[i]) {
+            configuration_masks_[i * num_words_ + v / 64] |= 1ULL << (v % 64);
+        }
+    }
+}
+
+int TransitionFilter::numWords() {
+    return num_words_;
+}
+
+void TransitionFilter::privateNeighborhoods(int i, vector<uint64_t> &private_masks) {
+    private_masks.assign(((size_t) configuration_size_) * num_words_, 0);
+
+    const uint64_t *configuration = &configuration_masks_[((size_t) i) * num_words_];
+
+    // dominated_once and dominated_twice get the vertices with at least one and at least two neighbors in the set
+    vector<uint64_t> dominated_once(num_words_, 0);
+    vector<uint64_t> dominated_twice(num_words_, 0);
+    for (int v = 0; v < num_vertices_; v++) {
+        if ((configuration[v / 64] >> (v % 64)) & 1ULL) {
+            const uint64_t *neighborhood = &neighborhood_masks_[((size_t) v) * num_words_];
+            for (int w = 0; w < num_words_; w++) {
+                dominated_twice[w] |= dominated_once[w] & neighborhood[w];
+                dominated_once[w] |= neighborhood[w];
+            }
+        }
+    }
+
+    int guard = 0;
+    for (int v = 0; v < num_vertices_; v++) {
+        if ((configuration[v / 64] >> (v % 64)) & 1ULL) {
+            const uint64_t *neighborhood = &neighborhood_masks_[((size_t) v) * num_words_];
+            for (int w = 0; w < num_words_; w++) {
+                private_masks[((size_t) guard) * num_words_ + w] = neighborhood[w] & ~dominated_twice[w];
+            }
+            guard++;
+        }
+    }
+}
+
+int TransitionFilter::filter(const vector<uint64_t> &private_masks, int begin, int end, vector<int> &survivors) {
+    if (end <= begin) {
+        return 0;
+    }
+
+    survivors.resize(end - begin);
+
+    if (num_words_ == 1) {
+        return filterSingleWord(private_masks, begin, end, survivors.data());
+    }
+    return filterScalar(private_masks, begin, end, survivors.data());
+}
+
+int TransitionFilter::filterScalar(const vector<uint64_t> &private_masks, int begin, int end, int *survivors) {
+    int num_survivors = 0;
+
+    for (int j = begin; j < end; j++) {
+        const uint64_t *candidate = &configuration_masks_[((size_t) j) * num_words_];
+
+        bool rejected = false;
+        for (int guard = 0; (guard < configuration_size_) && !rejected; guard++) {
+            const uint64_t *private_mask = &private_masks[((size_t) guard) * num_words_];
+
+            int count = 0;
+            for (int w = 0; w < num_words_; w++) {
+                count += __builtin_popcountll(candidate[w] & private_mask[w]);
+            }
+            rejected = (count > 1);
+        }
+
+        if (!rejected) {
+            survivors[num_survivors++] = j;
+        }
+    }
+
+    return num_survivors;
+}
+
+// with a single word per set, a candidate is rejected when x & (x - 1) != 0 for x = candidate & private mask
+// of some guard, and this is tested for 8 (AVX-512) or 4 (AVX2) candidates at a time
+int TransitionFilter::filterSingleWord(const vector<uint64_t> &private_masks, int begin, int end, int *survivors) {
+    const uint64_t *candidates = configuration_masks_.data();
+    int num_survivors = 0;
+    int j = begin;
+
+#if defined(__AVX512F__)
+    const __m512i one = _mm512_set1_epi64(1);
+    for (; j + 8 <= end; j += 8) {
+        __m512i block = _mm512_loadu_si512((const void *) (candidates + j));
+        __m512i rejected = _mm512_setzero_si512();
+        for (int guard = 0; guard < configuration_size_; guard++) {
+            __m512i x = _mm512_and_si512(block, _mm512_set1_epi64((long long) private_masks[guard]));
+            rejected = _mm512_or_si512(rejected, _mm512_and_si512(x, _mm512_sub_epi64(x, one)));
+        }
+
+        unsigned passed = _mm512_testn_epi64_mask(rejected, rejected);
+        while (passed) {
+            survivors[num_survivors++] = j + __builtin_ctz(passed);
+            passed &= passed - 1;
+        }
+    }
+#elif defined(__AVX2__)
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; j + 4 <= end; j += 4) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (candidates + j));
+        __m256i rejected = zero;
+        for (int guard = 0; guard < configuration_size_; guard++) {
+            __m256i x = _mm256_and_si256(block, _mm256_set1_epi64x((long long) private_masks[guard]));
+            rejected = _mm256_or_si256(rejected, _mm256_and_si256(x, _mm256_sub_epi64(x, one)));
+        }
+
+        unsigned passed = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(rejected, zero)));
+        while (passed) {
+            survivors[num_survivors++] = j + __builtin_ctz(passed);
+            passed &= passed - 1;
+        }
+    }
+#endif
+
+    for (; j < end; j++) {
+        uint64_t rejected = 0;
+        for (int guard = 0; guard < configuration_size_; guard++) {
+            uint64_t x = candidates[j] & private_masks[guard];
+            rejected |= x & (x - 1);
+        }
+
+        if (rejected == 0) {
+            survivors[num_survivors++] = j;
+        }
+    }
+
+    return num_survivors;
+}
@@ -0,0 +1,52 @@
+#ifndef TRANSITIONFILTER_H
+
+#define TRANSITIONFILTER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Graph;
+
+struct TransitionFilterStats {
+    std::size_t num_candidates = 0;
+    std::size_t num_rejected = 0;
+
+    double rejectRate() const;
+};
+
+//cheap necessary condition for a guard transition between two dominating sets, tested on bitmasks of
+//blocks of candidate sets before the exact check with a maximum matching
+//
+//for a dominating set S1, the private neighborhood of a guard w in S1 is the set of vertices whose only
+//neighbor (or themselves) in S1 is w; a guard can only move to one vertex, so S1 can not be transformed
+//into S2 if S2 has two vertices in the private neighborhood of the same guard
+class TransitionFilter {
+public:
+    //configurations are the dominating sets of the graph, all of the same size
+    TransitionFilter(Graph &graph, const std::vector<std::vector<int>> &configurations);
+
+    //number of 64 bit words of a bitmask of vertices
+    int numWords();
+
+    //compute the private neighborhoods of the guards of configuration i (numWords() words per guard)
+    void privateNeighborhoods(int i, std::vector<std::uint64_t> &private_masks);
+
+    //write to survivors the configurations j in [begin, end) that pass the filter for the private
+    //neighborhoods given, and return how many they are
+    int filter(const std::vector<std::uint64_t> &private_masks, int begin, int end, std::vector<int> &survivors);
+
+private:
+    int num_vertices_;
+    int num_words_;
+    int configuration_size_;
+
+    //bitmasks of the closed neighborhoods and of the configurations, numWords() words each
+    std::vector<std::uint64_t> neighborhood_masks_;
+    std::vector<std::uint64_t> configuration_masks_;
+
+    int filterScalar(const std::vector<std::uint64_t> &private_masks, int begin, int end, int *survivors);
+    int filterSingleWord(const std::vector<std::uint64_t> &private_masks, int begin, int end, int *survivors);
+};
+
+#endif /* TRANSITIONFILTER_H */
@@ -0,0 +1,149 @@
+#include "../Graph.h"
+#include "../InstanceGenerator.h"
+#include <exception>
+#include <stdexcept>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+void print_exception(const exception &e, int level = 0) {
+    cerr << "exception: " << string(level, ' ') << e.what() << "\n";
+    try {
+        rethrow_if_nested(e);
+    } catch(const std::exception& nested_exception) {
+        print_exception(nested_exception, (level + 2));
+    }
+}
+
+void print_usage(const char *program) {
+    cerr << "Usage: " << program << " [options] family parameters...\n"
+        << "Options:\n"
+        << "  --seed S      seed of the first instance (default: 1)\n"
+        << "  --count C     number of instances, generated with seeds S, S + 1, ... (default: 1)\n"
+        << "  --output DIR  directory where the instances are written (default: .)\n"
+        << "Families:\n"
+        << "  grid2d X Y\n"
+        << "  grid3d X Y Z\n"
+        << "  cycle N\n"
+        << "  path N\n"
+        << "  tree N                 random tree\n"
+        << "  gnp N P                random graph G(N, P)\n"
+        << "  circulant N J1 J2 ...  Cayley graph of Z_N with jumps J1, J2, ...\n"
+        << "  cyclic-cayley N D      random Cayley graph of Z_N with D generators\n"
+        << "  abelian-cayley A B D   random Cayley graph of Z_A x Z_B with D generators\n"
+        << "  dihedral-cayley M D    random Cayley graph of the dihedral group of order 2M with D generators\n";
+}
+
+Graph generate(const string &family, const vector<string> &params, Random &random) {
+    auto expect = [&](size_t count) {
+        if (params.size() != count) {
+            throw invalid_argument("Family " + family + " expects " + to_string(count) + " parameters");
+        }
+    };
+
+    if (family == "grid2d") {
+        expect(2);
+        return InstanceGenerator::grid2D(stoi(params[0]), stoi(params[1]));
+    }
+    if (family == "grid3d") {
+        expect(3);
+        return InstanceGenerator::grid3D(stoi(params[0]), stoi(params[1]), stoi(params[2]));
+    }
+    if (family == "cycle") {
+        expect(1);
+        return InstanceGenerator::cycle(stoi(params[0]));
+    }
+    if (family == "path") {
+        expect(1);
+        return InstanceGenerator::path(stoi(params[0]));
+    }
+    if (family == "tree") {
+        expect(1);
+        return InstanceGenerator::randomTree(stoi(params[0]), random);
+    }
+    if (family == "gnp") {
+        expect(2);
+        return InstanceGenerator::gnp(stoi(params[0]), stod(params[1]), random);
+    }
+    if (family == "circulant") {
+        if (params.size() < 2) {
+            throw invalid_argument("Family circulant expects at least 2 parameters");
+        }
+        vector<int> jumps;
+        for (size_t i = 1; i < params.size(); i++) {
+            jumps.push_back(stoi(params[i]));
+        }
+        return InstanceGenerator::circulant(stoi(params[0]), jumps);
+    }
+    if (family == "cyclic-cayley") {
+        expect(2);
+        return InstanceGenerator::randomCyclicCayley(stoi(params[0]), stoi(params[1]), random);
+    }
+    if (family == "abelian-cayley") {
+        expect(3);
+        return InstanceGenerator::randomAbelianCayley(stoi(params[0]), stoi(params[1]), stoi(params[2]), random);
+    }
+    if (family == "dihedral-cayley") {
+        expect(2);
+        return InstanceGenerator::randomDihedralCayley(stoi(params[0]), stoi(params[1]), random);
+    }
+
+    throw invalid_argument("Invalid family: " + family);
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = 1;
+    long long count = 1;
+    string output_dir = ".";
+    string family;
+    vector<string> params;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if ((arg.substr(0, 2) == "--") && (i + 1 >= argc)) {
+                throw invalid_argument("Missing value for option " + arg);
+            }
+
+            if (arg == "--seed") {
+                seed = stoull(argv[++i]);
+            } else if (arg == "--count") {
+                count = stoll(argv[++i]);
+            } else if (arg == "--output") {
+                output_dir = argv[++i];
+            } else if (family.empty()) {
+                family = arg;
+            } else {
+                params.push_back(arg);
+            }
+        }
+
+        if (family.empty() || (count < 1)) {
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        string name = family;
+        for (auto &p : params) {
+            name += "_" + p;
+        }
+
+        for (long long i = 0; i < count; i++) {
+            Random random(seed + i);
+            Graph g = generate(family, params, random);
+
+            string filename = output_dir + "/" + name + "_s" + to_string(seed + i) + ".txt";
+            g.save(filename);
+            cout << filename << "\n";
+        }
+    } catch (const std::exception& e) {
+        print_exception(e);
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "../StrategyTable.h"
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+
+using namespace std;
+
+void print_exception(const exception &e, int level = 0) {
+    cerr << "exception: " << string(level, ' ') << e.what() << "\n";
+    try {
+        rethrow_if_nested(e);
+    } catch(const std::exception& nested_exception) {
+        print_exception(nested_exception, (level + 2));
+    }
+}
+
+void print_usage(const char *program) {
+    cerr << "Usage: " << program << " [--list] strategy_file [configuration attacked_vertex]\n"
+        << "  --list         print the configurations of the table and their indices\n"
+        << "The configuration is an index of the table or its vertices separated by commas (e.g. 1,4,7).\n"
+        << "Without a query, the queries are read from the standard input, one per line.\n"
+        << "Each response is written as the index of the next configuration followed by the move\n"
+        << "of each guard (from>to); the vertices are numbered from 1 to n.\n";
+}
+
+int parse_configuration(StrategyTable &table, const string &value) {
+    if (value.find(',') == string::npos) {
+        int c = stoi(value);
+        if ((c < 0) || (c >= table.numConfigurations())) {
+            throw invalid_argument("Invalid configuration index: " + value);
+        }
+        return c;
+    }
+
+    // vertices are numbered from 1 to n
+    vector<int> vertices;
+    stringstream stream(value);
+    string vertex;
+    while (getline(stream, vertex, ',')) {
+        vertices.push_back(stoi(vertex) - 1);
+    }
+
+    int c = table.findConfiguration(vertices);
+    if (c < 0) {
+        throw invalid_argument("The configuration " + value + " is not in the table");
+    }
+    return c;
+}
+
+void answer(StrategyTable &table, const string &configuration, const string &attacked) {
+    int c = parse_configuration(table, configuration);
+    int a = stoi(attacked) - 1;
+    if ((a < 0) || (a >= table.numVertices())) {
+        throw invalid_argument("Invalid attacked vertex: " + attacked);
+    }
+
+    const uint16_t *guards = table.configuration(c);
+    const uint16_t *destinations = table.destinations(c, a);
+
+    string response = to_string(table.successor(c, a));
+    for (int g = 0; g < table.k(); g++) {
+        response += " " + to_string(guards[g] + 1) + ">" + to_string(destinations[g] + 1);
+    }
+    cout << response << "\n";
+}
+
+int main(int argc, char *argv[]) {
+    vector<string> args;
+    bool list = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--list") {
+            list = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    if ((args.size() != 1) && (args.size() != 3)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        StrategyTable table(args[0]);
+
+        if (list) {
+            for (int c = 0; c < table.numConfigurations(); c++) {
+                const uint16_t *guards = table.configuration(c);
+                cout << c << ":";
+                for (int g = 0; g < table.k(); g++) {
+                    cout << " " << (guards[g] + 1);
+                }
+                cout << "\n";
+            }
+        }
+
+        if (args.size() == 3) {
+            answer(table, args[1], args[2]);
+            return 0;
+        }
+
+        if (list) {
+            return 0;
+        }
+
+        // the responses are flushed after each query, so a controller can wait for them
+        string configuration, attacked;
+        while (cin >> configuration >> attacked) {
+            try {
+                answer(table, configuration, attacked);
+            } catch (const std::exception& e) {
+                print_exception(e);
+            }
+            cout << flush;
+        }
+    } catch (const std::exception& e) {
+        print_exception(e);
+        return 1;
+    }
+
+    return 0;
+}